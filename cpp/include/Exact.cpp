@@ -0,0 +1,686 @@
+#include "Partition.hpp"
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <unordered_set>
+
+namespace partition {
+
+namespace {
+// Entry of a Karmarkar-Karp list: a two-way partial partition whose sides
+// differ by value. node identifies it in the differencing tree.
+struct KkEntry {
+  ValueType value;
+  uint32_t node;
+};
+
+// Internal node of the differencing tree. Its larger side is the larger side
+// of a joined with the larger (sum) or smaller (difference) side of b.
+struct KkNode {
+  uint32_t a;
+  uint32_t b;
+  bool sum;
+};
+
+// Search nodes visited between two polls of the solve control.
+constexpr std::size_t RNP_POLL_INTERVAL = 4096;
+
+/**
+ * @brief Decision search of Recursive Number Partitioning: looks for any
+ * partition with makespan below the incumbent and stops at the first one.
+ *
+ * With k groups left, the search picks the group of the largest remaining
+ * item: every subset that contains it and whose sum lets the rest still fit
+ * into k - 1 groups below the incumbent. The remaining items are partitioned
+ * recursively; the last two groups are split by Complete Karmarkar-Karp.
+ */
+struct RnpSearch {
+  const std::vector<ValueType> &values; // decreasing order
+  ValueType lowerbound;
+  ValueType incumbent;             // makespan to beat
+  std::vector<GroupIndex> current; // group of each value, partial solution
+  std::vector<GroupIndex> best;    // group of each value, best solution
+  bool improved = false;
+  const SolveControl &control;
+  bool stopped = false; // the control asked to stop
+  std::size_t steps = 0;
+
+  // Complete Karmarkar-Karp state of the current two-way split
+  const std::vector<uint32_t> *ckkItems = nullptr;
+  GroupIndex ckkGroup = 0;
+  ValueType ckkFixed = 0; // largest load of the groups already fixed
+  ValueType ckkTotal = 0; // sum of the items being split
+  std::vector<KkNode> nodes;
+  std::vector<std::vector<KkEntry>> levels;
+
+  RnpSearch(const std::vector<ValueType> &values, ValueType lowerbound,
+            ValueType incumbent, const SolveControl &control)
+      : values(values), lowerbound(lowerbound), incumbent(incumbent),
+        current(values.size(), 0), best(values.size(), 0), control(control) {}
+
+  // Stop at the first solution or once nothing can be below the lower bound
+  bool finished() const {
+    return improved || stopped || incumbent <= lowerbound;
+  }
+
+  // Counts a search node and polls the control every RNP_POLL_INTERVAL nodes.
+  bool poll() {
+    if (++steps % RNP_POLL_INTERVAL == 0 && control.stopRequested()) {
+      stopped = true;
+    }
+    return stopped;
+  }
+
+  /**
+   * @brief Splits items (indices into values, decreasing) into k groups
+   * numbered from group on, below the incumbent.
+   *
+   * @param items The items to partition.
+   * @param k The number of groups left.
+   * @param group The first free group index.
+   * @param fixedMax The largest load of the groups already filled.
+   */
+  void partition(const std::vector<uint32_t> &items, std::size_t k,
+                 GroupIndex group, ValueType fixedMax) {
+    ValueType total = 0;
+    for (uint32_t item : items) {
+      total += values[item];
+    }
+
+    ValueType bound =
+        std::max({fixedMax, values[items.front()], (total + k - 1) / k});
+    if (bound >= incumbent) {
+      return;
+    }
+
+    if (k == 2) {
+      completeKarmarkarKarp(items, group, fixedMax, total);
+      return;
+    }
+
+    std::vector<ValueType> suffix(items.size() + 1, 0);
+    for (std::size_t j = items.size(); j-- > 0;) {
+      suffix[j] = suffix[j + 1] + values[items[j]];
+    }
+
+    std::vector<char> taken(items.size(), 0);
+    taken[0] = 1;
+    current[items[0]] = group;
+    chooseSubset(items, suffix, taken, 1, values[items[0]], total, k, group,
+                 fixedMax);
+  }
+
+  /**
+   * @brief Enumerates, largest sums first, the subsets that can be the next
+   * group and recurses on the remaining items for each of them.
+   */
+  void chooseSubset(const std::vector<uint32_t> &items,
+                    const std::vector<ValueType> &suffix,
+                    std::vector<char> &taken, std::size_t j, ValueType sum,
+                    ValueType total, std::size_t k, GroupIndex group,
+                    ValueType fixedMax) {
+    if (poll() || finished()) {
+      return;
+    }
+
+    // Every group must stay below the incumbent, so the rest must fit into
+    // k - 1 groups of at most incumbent - 1
+    ValueType high = incumbent - 1;
+    unsigned __int128 restCapacity =
+        static_cast<unsigned __int128>(k - 1) * high;
+    ValueType low = restCapacity >= total ? 0 : ValueType(total - restCapacity);
+    if (sum > high || sum + suffix[j] < low) {
+      return;
+    }
+
+    if (j == items.size()) {
+      std::vector<uint32_t> rest;
+      rest.reserve(items.size());
+      for (std::size_t t = 0; t < items.size(); t++) {
+        if (!taken[t]) {
+          rest.push_back(items[t]);
+        }
+      }
+      if (!rest.empty()) {
+        partition(rest, k - 1, group + 1, std::max(fixedMax, sum));
+      }
+      return;
+    }
+
+    ValueType value = values[items[j]];
+    if (sum + value <= high) {
+      taken[j] = 1;
+      current[items[j]] = group;
+      chooseSubset(items, suffix, taken, j + 1, sum + value, total, k, group,
+                   fixedMax);
+      taken[j] = 0;
+    }
+    chooseSubset(items, suffix, taken, j + 1, sum, total, k, group, fixedMax);
+  }
+
+  /**
+   * @brief Splits items into groups group and group + 1 with the smallest
+   * possible difference, stopping once the split cannot lower the makespan.
+   */
+  void completeKarmarkarKarp(const std::vector<uint32_t> &items,
+                             GroupIndex group, ValueType fixedMax,
+                             ValueType total) {
+    ckkItems = &items;
+    ckkGroup = group;
+    ckkFixed = fixedMax;
+    ckkTotal = total;
+    nodes.clear();
+
+    if (levels.size() < items.size() + 1) {
+      levels.resize(items.size() + 1);
+    }
+    std::vector<KkEntry> &root = levels[0];
+    root.clear();
+    for (std::size_t t = 0; t < items.size(); t++) {
+      root.push_back({values[items[t]], uint32_t(t)});
+    }
+    kkSearch(0, total);
+  }
+
+  // The split cannot lower the makespan any further
+  bool ckkDone() const {
+    return finished() ||
+           incumbent <= std::max(ckkFixed, ckkTotal - ckkTotal / 2);
+  }
+
+  // total is the sum of the entries of the list at depth, not of the items
+  void kkSearch(std::size_t depth, ValueType total) {
+    const std::vector<KkEntry> &list = levels[depth];
+    ValueType largest = list[0].value;
+    ValueType rest = total - largest;
+
+    // The largest entry against everything else is the best completion
+    if (list.size() == 1 || largest >= rest) {
+      ValueType difference = largest - rest;
+      if (ckkTotal + difference < 2 * incumbent) {
+        record(list, difference);
+      }
+      return;
+    }
+    if (poll() || ckkDone()) {
+      return;
+    }
+
+    KkEntry a = list[0];
+    KkEntry b = list[1];
+    uint32_t node = uint32_t(ckkItems->size() + nodes.size());
+    std::vector<KkEntry> &child = levels[depth + 1];
+
+    // Difference: put a and b on opposite sides (Karmarkar-Karp first)
+    nodes.push_back({a.node, b.node, false});
+    ValueType difference = a.value - b.value;
+    child.clear();
+    std::size_t t = 2;
+    for (; t < list.size() && list[t].value > difference; t++) {
+      child.push_back(list[t]);
+    }
+    child.push_back({difference, node});
+    child.insert(child.end(), list.begin() + t, list.end());
+    kkSearch(depth + 1, total - 2 * b.value);
+    nodes.pop_back();
+
+    if (ckkDone()) {
+      return;
+    }
+
+    // Sum: put a and b on the same side
+    nodes.push_back({a.node, b.node, true});
+    child.clear();
+    child.push_back({a.value + b.value, node});
+    child.insert(child.end(), list.begin() + 2, list.end());
+    kkSearch(depth + 1, total);
+    nodes.pop_back();
+  }
+
+  // Stores the split of the first entry against all the others.
+  void record(const std::vector<KkEntry> &list, ValueType difference) {
+    assignSide(list[0].node, false);
+    for (std::size_t t = 1; t < list.size(); t++) {
+      assignSide(list[t].node, true);
+    }
+
+    incumbent = std::max(ckkFixed, (ckkTotal + difference) / 2);
+    best = current;
+    improved = true;
+  }
+
+  void assignSide(uint32_t node, bool side) {
+    const std::size_t leaves = ckkItems->size();
+    if (node < leaves) {
+      current[(*ckkItems)[node]] = ckkGroup + (side ? 1 : 0);
+      return;
+    }
+    const KkNode &inner = nodes[node - leaves];
+    assignSide(inner.a, side);
+    assignSide(inner.b, inner.sum ? side : !side);
+  }
+};
+// Marks a sum no item has reached yet.
+constexpr uint32_t DP_UNREACHED = std::numeric_limits<uint32_t>::max();
+
+/**
+ * @brief Two-way subset-sum DP over a packed bitset of reachable sums.
+ *
+ * Every item ORs the bitset with itself shifted by its value, a word at a
+ * time from the top so the words read are still the old ones. The item that
+ * first reaches each sum is recorded, which is enough to walk any sum back to
+ * a subset. Only sums up to total / 2 are tracked.
+ *
+ * @param arr The values to split.
+ * @param budget The memory the tables may use, in bytes.
+ * @param groupOf Receives 1 for the items of the lighter side, 0 otherwise.
+ * @return false, without touching groupOf, if the tables exceed budget.
+ */
+bool twoWayDP(const std::vector<ValueType> &arr, std::size_t budget,
+              std::vector<GroupIndex> &groupOf) {
+  ValueType total = std::accumulate(arr.begin(), arr.end(), ValueType{0});
+  ValueType half = total / 2;
+  if (half >= budget / (sizeof(uint32_t) + 1)) {
+    return false;
+  }
+
+  const std::size_t words = std::size_t(half / 64) + 1;
+  const unsigned topBits = unsigned(half % 64) + 1;
+  const uint64_t topMask = topBits == 64 ? ~uint64_t{0}
+                                         : (uint64_t{1} << topBits) - 1;
+
+  std::vector<uint64_t> reach(words, 0);
+  std::vector<uint32_t> firstItem(std::size_t(half) + 1, DP_UNREACHED);
+  reach[0] = 1;
+
+  for (std::size_t i = 0; i < arr.size(); i++) {
+    ValueType value = arr[i];
+    if (value == 0 || value > half) {
+      continue;
+    }
+
+    const std::size_t shift = std::size_t(value / 64);
+    const unsigned bits = unsigned(value % 64);
+    for (std::size_t w = words; w-- > shift;) {
+      uint64_t shifted = reach[w - shift] << bits;
+      if (bits != 0 && w > shift) {
+        shifted |= reach[w - shift - 1] >> (64 - bits);
+      }
+      if (w == words - 1) {
+        shifted &= topMask;
+      }
+
+      uint64_t fresh = shifted & ~reach[w];
+      reach[w] |= fresh;
+      for (; fresh != 0; fresh &= fresh - 1) {
+        firstItem[w * 64 + unsigned(__builtin_ctzll(fresh))] = uint32_t(i);
+      }
+    }
+  }
+
+  // Largest reachable sum on the lighter side
+  std::size_t w = words - 1;
+  while (reach[w] == 0) {
+    w--;
+  }
+  ValueType sum = w * 64 + (63 - unsigned(__builtin_clzll(reach[w])));
+
+  // The item that first reached a sum was added to a sum reached only by
+  // earlier items, so the walk never reuses one
+  groupOf.assign(arr.size(), 0);
+  while (sum > 0) {
+    uint32_t item = firstItem[sum];
+    groupOf[item] = 1;
+    sum -= arr[item];
+  }
+  return true;
+}
+
+// Outcome of the multi-way DP.
+enum class DpResult { Exceeded, NoBetter, Found };
+
+/**
+ * @brief Multi-way DP over the reachable load vectors.
+ *
+ * Items are added in decreasing order. A state is the multiset of group loads,
+ * stored in decreasing order so permuted groups collapse into one; every item
+ * goes once to each distinct load. A state is dropped when its makespan
+ * reaches upper, when its smallest load cannot take the next item below upper,
+ * or when the items left cannot lift every group to the least load that lets
+ * the others stay below upper.
+ * Each state keeps its parent and the load the item was added to, which is
+ * replayed forward on labelled groups to rebuild the assignment.
+ *
+ * @param arr The values to partition.
+ * @param n The number of groups (at least 3).
+ * @param upper The makespan to beat.
+ * @param budget The memory the state tables may use, in bytes.
+ * @param groupOf Receives the group of each item when a better one is found.
+ */
+DpResult multiWayDP(const std::vector<ValueType> &arr, std::size_t n,
+                    ValueType upper, std::size_t budget,
+                    std::vector<GroupIndex> &groupOf) {
+  const std::size_t m = arr.size();
+  ValueType total = std::accumulate(arr.begin(), arr.end(), ValueType{0});
+  unsigned __int128 othersCapacity =
+      static_cast<unsigned __int128>(n - 1) * (upper - 1);
+  ValueType least =
+      othersCapacity >= total ? 0 : ValueType(total - othersCapacity);
+
+  std::vector<ItemIndex> order(m);
+  std::iota(order.begin(), order.end(), ItemIndex{0});
+  std::stable_sort(
+      order.begin(), order.end(),
+      [&arr](ItemIndex a, ItemIndex b) { return arr[a] > arr[b]; });
+
+  // Per state: n loads, the parent state and the load the item went to
+  std::vector<ValueType> loads(n, 0);
+  std::vector<uint32_t> parent(1, DP_UNREACHED);
+  std::vector<ValueType> from(1, 0);
+  std::vector<std::size_t> layerStart = {0, 1};
+
+  const std::size_t stateBytes =
+      n * sizeof(ValueType) + sizeof(uint32_t) + sizeof(ValueType);
+  const std::size_t indexBytes = 4 * sizeof(void *); // hash set node
+
+  auto hash = [&loads, n](uint32_t state) {
+    std::size_t h = 0;
+    for (std::size_t k = 0; k < n; k++) {
+      h = h * 0x9E3779B97F4A7C15ULL + std::size_t(loads[state * n + k]);
+    }
+    return h ^ (h >> 29);
+  };
+  auto equal = [&loads, n](uint32_t a, uint32_t b) {
+    return std::equal(loads.begin() + a * n, loads.begin() + (a + 1) * n,
+                      loads.begin() + b * n);
+  };
+  std::unordered_set<uint32_t, decltype(hash), decltype(equal)> layer(
+      0, hash, equal);
+
+  std::vector<ValueType> tuple(n);
+  ValueType rest = total;
+  for (std::size_t t = 0; t < m; t++) {
+    const ValueType value = arr[order[t]];
+    const ValueType nextValue = t + 1 < m ? arr[order[t + 1]] : 0;
+    rest -= value;
+    layer.clear();
+
+    for (std::size_t state = layerStart[t]; state < layerStart[t + 1];
+         state++) {
+      for (std::size_t j = 0; j < n; j++) {
+        ValueType load = loads[state * n + j];
+        if (j > 0 && load == loads[state * n + j - 1]) {
+          continue;
+        }
+        if (load + value >= upper) {
+          continue;
+        }
+
+        std::copy(loads.begin() + state * n, loads.begin() + (state + 1) * n,
+                  tuple.begin());
+        tuple[j] += value;
+        for (std::size_t k = j; k > 0 && tuple[k - 1] < tuple[k]; k--) {
+          std::swap(tuple[k - 1], tuple[k]);
+        }
+        if (tuple[n - 1] + nextValue >= upper) {
+          continue;
+        }
+        ValueType missing = 0;
+        for (std::size_t k = n; k-- > 0 && tuple[k] < least;) {
+          missing += least - tuple[k];
+        }
+        if (missing > rest) {
+          continue;
+        }
+
+        uint32_t child = uint32_t(parent.size());
+        loads.insert(loads.end(), tuple.begin(), tuple.end());
+        if (!layer.insert(child).second) {
+          loads.resize(loads.size() - n);
+          continue;
+        }
+        parent.push_back(uint32_t(state));
+        from.push_back(load);
+      }
+
+      if (parent.size() * stateBytes + layer.size() * indexBytes > budget) {
+        return DpResult::Exceeded;
+      }
+    }
+    layerStart.push_back(parent.size());
+  }
+
+  // Best complete state
+  if (layerStart[m] == layerStart[m + 1]) {
+    return DpResult::NoBetter;
+  }
+  std::size_t best = layerStart[m];
+  for (std::size_t state = best + 1; state < layerStart[m + 1]; state++) {
+    if (loads[state * n] < loads[best * n]) {
+      best = state;
+    }
+  }
+
+  std::vector<std::size_t> path(m + 1);
+  for (std::size_t t = m + 1; t-- > 0;) {
+    path[t] = best;
+    best = parent[best];
+  }
+
+  std::vector<ValueType> groupLoads(n, 0);
+  groupOf.assign(m, 0);
+  for (std::size_t t = 0; t < m; t++) {
+    ValueType load = from[path[t + 1]];
+    std::size_t g = 0;
+    while (groupLoads[g] != load) {
+      g++;
+    }
+    groupLoads[g] += arr[order[t]];
+    groupOf[order[t]] = GroupIndex(g);
+  }
+  return DpResult::Found;
+}
+
+// Fills out from the group of every item.
+void assignFromGroupOf(const std::vector<ValueType> &arr, std::size_t n,
+                       const std::vector<GroupIndex> &groupOf,
+                       Assignment &out) {
+  out.groupOf = groupOf;
+  out.loads.assign(n, 0);
+  for (std::size_t i = 0; i < arr.size(); i++) {
+    out.loads[groupOf[i]] += arr[i];
+  }
+  out.makespan = *std::max_element(out.loads.begin(), out.loads.end());
+}
+} // namespace
+
+void RNP(const std::vector<ValueType> &arr, std::size_t n, Assignment &out) {
+  RNP(arr, n, out, SolveControl{});
+}
+
+SolveStatus RNP(const std::vector<ValueType> &arr, std::size_t n,
+                Assignment &out, const SolveControl &control) {
+  if (n == 0) {
+    throw std::invalid_argument("n must be a positive integer");
+  }
+  const auto start = SolveControl::Clock::now();
+
+  // Upper bound: the better of LPT and MULTIFIT
+  SolveStatus status;
+  LPT(arr, n, out);
+  if (n == 1 || arr.size() <= n) {
+    status.optimal = true;
+    status.lowerBound = out.makespan;
+    return status;
+  }
+  Assignment multifit;
+  MULTIFIT(arr, n, multifit);
+  if (multifit.makespan < out.makespan) {
+    out = std::move(multifit);
+  }
+
+  std::vector<ItemIndex> order(arr.size());
+  std::iota(order.begin(), order.end(), ItemIndex{0});
+  std::stable_sort(
+      order.begin(), order.end(),
+      [&arr](ItemIndex a, ItemIndex b) { return arr[a] > arr[b]; });
+
+  std::vector<ValueType> sorted(arr.size());
+  for (std::size_t i = 0; i < order.size(); i++) {
+    sorted[i] = arr[order[i]];
+  }
+
+  ValueType total = std::accumulate(sorted.begin(), sorted.end(), ValueType{0});
+  ValueType lowerbound =
+      std::max<ValueType>(sorted.front(), (total + n - 1) / n);
+
+  // Galloping search over the makespan: probe lowerbound, lowerbound + 1,
+  // lowerbound + 3, ... until a probe succeeds, then bisect. Tight targets
+  // keep the subset windows of each probe narrow, where a descending
+  // branch-and-bound would lower the incumbent a unit at a time.
+  std::vector<uint32_t> items(sorted.size());
+  std::iota(items.begin(), items.end(), uint32_t{0});
+
+  ValueType failed = lowerbound - 1; // largest makespan known impossible
+  ValueType step = 1;
+  bool galloping = true;
+  control.report(start, out.makespan, failed + 1);
+  PARTITION_STAT(SolveStats *stats = currentStats());
+  PARTITION_STAT(SolveStats counts);
+  PARTITION_STAT(if (stats) stats->improved());
+  while (failed + 1 < out.makespan) {
+    if (control.stopRequested()) {
+      status.interrupted = true;
+      break;
+    }
+
+    ValueType target = galloping ? std::min(failed + step, out.makespan - 1)
+                                 : failed + (out.makespan - failed) / 2;
+
+    RnpSearch search(sorted, lowerbound, target + 1, control);
+    search.partition(items, n, 0, 0);
+    PARTITION_STAT(counts.nodes += search.steps);
+    if (search.stopped && !search.improved) {
+      status.interrupted = true;
+      break;
+    }
+    if (!search.improved) {
+      failed = target;
+      step *= 2;
+      continue;
+    }
+
+    galloping = false;
+    std::fill(out.loads.begin(), out.loads.end(), 0);
+    for (std::size_t i = 0; i < sorted.size(); i++) {
+      out.groupOf[order[i]] = search.best[i];
+      out.loads[search.best[i]] += sorted[i];
+    }
+    out.makespan = *std::max_element(out.loads.begin(), out.loads.end());
+    control.report(start, out.makespan, failed + 1);
+    PARTITION_STAT(if (stats) stats->improved());
+  }
+  PARTITION_STAT(if (stats) stats->add(counts));
+
+  status.optimal = !status.interrupted;
+  status.lowerBound = status.optimal ? out.makespan : failed + 1;
+  return status;
+}
+
+bool DP(const std::vector<ValueType> &arr, std::size_t n, Assignment &out,
+        std::size_t memoryBudget) {
+  if (n == 0) {
+    throw std::invalid_argument("n must be a positive integer");
+  }
+  if (n == 1 || arr.size() <= n) {
+    LPT(arr, n, out);
+    return true;
+  }
+
+  std::vector<GroupIndex> groupOf;
+  if (n == 2) {
+    if (!twoWayDP(arr, memoryBudget, groupOf)) {
+      return false;
+    }
+    assignFromGroupOf(arr, n, groupOf, out);
+    return true;
+  }
+
+  // Upper bound: the better of LPT and KK
+  Assignment heuristic, kk;
+  LPT(arr, n, heuristic);
+  KK(arr, n, kk);
+  if (kk.makespan < heuristic.makespan) {
+    heuristic = std::move(kk);
+  }
+
+  // Galloping search over the makespan, as in RNP: the tighter the target,
+  // the fewer load vectors survive each layer
+  ValueType total = std::accumulate(arr.begin(), arr.end(), ValueType{0});
+  ValueType lowerbound = std::max<ValueType>(
+      *std::max_element(arr.begin(), arr.end()), (total + n - 1) / n);
+
+  ValueType failed = lowerbound - 1; // largest makespan known impossible
+  ValueType step = 1;
+  bool galloping = true;
+  while (failed + 1 < heuristic.makespan) {
+    ValueType target = galloping
+                           ? std::min(failed + step, heuristic.makespan - 1)
+                           : failed + (heuristic.makespan - failed) / 2;
+
+    switch (multiWayDP(arr, n, target + 1, memoryBudget, groupOf)) {
+    case DpResult::Exceeded:
+      return false;
+    case DpResult::NoBetter:
+      failed = target;
+      step *= 2;
+      break;
+    case DpResult::Found:
+      galloping = false;
+      assignFromGroupOf(arr, n, groupOf, heuristic);
+      break;
+    }
+  }
+  out = std::move(heuristic);
+  return true;
+}
+
+void solveExact(const std::vector<ValueType> &arr, std::size_t n,
+                Assignment &out, ExactSolver solver, const CgaOptions &cga) {
+  solveExact(arr, n, out, solver, cga, SolveControl{});
+}
+
+SolveStatus solveExact(const std::vector<ValueType> &arr, std::size_t n,
+                       Assignment &out, ExactSolver solver,
+                       const CgaOptions &cga, const SolveControl &control) {
+  SolveStatus proven;
+  switch (solver) {
+  case ExactSolver::CGA:
+    return CGA(arr, n, out, cga, control);
+  case ExactSolver::RNP:
+    return RNP(arr, n, out, control);
+  case ExactSolver::DP:
+    if (!DP(arr, n, out)) {
+      throw std::length_error("DP tables exceed the memory budget");
+    }
+    break;
+  case ExactSolver::Auto:
+    // The load-vector table only pays off against CGA's pruning on tiny sums,
+    // so the DP is only picked for two groups
+    if (n != 2 || !DP(arr, n, out)) {
+      return CGA(arr, n, out, cga, control);
+    }
+    break;
+  }
+
+  proven.optimal = true;
+  proven.lowerBound = out.makespan;
+  return proven;
+}
+
+Groups RNP(const std::vector<ValueType> &arr, std::size_t n) {
+  Assignment assignment;
+  RNP(arr, n, assignment);
+  return toGroups(arr, assignment);
+}
+} // namespace partition
@@ -0,0 +1,1294 @@
+#include "Partition.hpp"
+#include "ThreadPool.hpp"
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace partition {
+
+namespace {
+// Makespan no solution can beat: the larger of ceil(sum / n) and the
+// largest item.
+ValueType makespanLowerBound(const std::vector<ValueType> &arr, std::size_t n) {
+  if (arr.empty()) {
+    return 0;
+  }
+  ValueType sum = std::accumulate(arr.begin(), arr.end(), ValueType{0});
+  return std::max((sum + n - 1) / n, *std::max_element(arr.begin(), arr.end()));
+}
+
+// Status of a heuristic solve, which proves optimality only by reaching the
+// lower bound.
+SolveStatus heuristicStatus(const std::vector<ValueType> &arr, std::size_t n,
+                            const Assignment &out, bool interrupted) {
+  SolveStatus status;
+  status.lowerBound = makespanLowerBound(arr, n);
+  status.optimal = out.makespan <= status.lowerBound;
+  status.interrupted = interrupted && !status.optimal;
+  return status;
+}
+
+// Random generator for the per-task streams of the metaheuristics
+// (SplitMix64): one word of state, so a stream per child costs nothing.
+class SplitMix64 {
+public:
+  using result_type = uint64_t;
+
+  explicit SplitMix64(uint64_t seed) : state_(seed) {}
+
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  result_type operator()() {
+    uint64_t z = (state_ += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+  }
+
+private:
+  uint64_t state_;
+};
+
+// Seed of the stream of task t of round r, decorrelated from its neighbours.
+uint64_t streamSeed(uint64_t seed, uint64_t r, uint64_t t) {
+  return SplitMix64(seed ^ (r << 32) ^ t)();
+}
+
+// 64-bit hash of a genome, the key of the fitness cache.
+template <typename Gene>
+uint64_t hashGenome(const Gene *genes, std::size_t length) {
+  static_assert(sizeof(Gene) <= sizeof(uint64_t), "gene wider than a word");
+  uint64_t h = 0xcbf29ce484222325ULL ^ length;
+  for (std::size_t i = 0; i < length; i++) {
+    uint64_t bits = 0;
+    std::memcpy(&bits, &genes[i], sizeof(Gene));
+    h = (h ^ bits) * 0x100000001b3ULL;
+    h ^= h >> 29;
+  }
+  return SplitMix64(h)();
+}
+
+// Least amount of work (genes touched) worth spreading over the pool.
+constexpr std::size_t GA_PARALLEL_MIN_WORK = std::size_t(1) << 14;
+
+// Runs body(i) for i in [0, count), on the shared pool when allowed and it
+// pays off.
+void forEachGenome(std::size_t count, std::size_t length, bool parallel,
+                   const std::function<void(std::size_t)> &body) {
+  ThreadPool &pool = ThreadPool::shared();
+  if (parallel && pool.size() > 1 && count > 1 &&
+      count * length >= GA_PARALLEL_MIN_WORK) {
+    pool.parallelFor(count, body);
+  } else {
+    for (std::size_t i = 0; i < count; i++) {
+      body(i);
+    }
+  }
+}
+
+struct GeneticSettings {
+  std::size_t maxPopulation = 50;    // QUEUE_MAX_SIZE
+  std::size_t initialPopulation = 20;
+  std::size_t crossoverFactor = 2;   // offspring = population / factor
+  std::size_t maxStall = 5;          // generations without improvement
+  bool parallel = true;              // GeneticOptions::parallel
+};
+
+/**
+ * @brief Generational engine shared by both genetic algorithms.
+ *
+ * Genomes of a fixed length live in one preallocated buffer of slots, and the
+ * population is the list of live slots ranked by fitness (makespan, lower is
+ * better), capped at maxPopulation. Every generation breeds its offspring from
+ * the population as it stood at the start of the generation, so children are
+ * bred and scored in parallel, each with its own random stream. Fitness is
+ * looked up by genome hash first, so repeated individuals are scored once.
+ *
+ * @param length The number of genes of a genome.
+ * @param settings Population sizes and the stopping rule.
+ * @param target A makespan that cannot be improved on (stops the search).
+ * @param seed Seed of the random streams of the children.
+ * @param init init(i, genome) writes the i-th initial individual.
+ * @param breed breed(parent1, parent2, child, rng) writes a child.
+ * @param fitness fitness(genome) scores a genome; called concurrently.
+ * @param control Checked between generations; told of every new best.
+ * @param best Receives the best genome found.
+ * @return Whether the control stopped the search.
+ */
+template <typename Gene, typename Init, typename Breed, typename Fitness>
+bool evolve(std::size_t length, const GeneticSettings &settings,
+            ValueType target, uint64_t seed, Init init, Breed breed,
+            Fitness fitness, const SolveControl &control,
+            std::vector<Gene> &best) {
+  const auto start = SolveControl::Clock::now();
+  const std::size_t maxChildren =
+      std::max<std::size_t>(1, settings.maxPopulation / settings.crossoverFactor);
+  const std::size_t slots =
+      std::max(settings.maxPopulation, settings.initialPopulation) +
+      maxChildren;
+
+  std::vector<Gene> genes(slots * length);
+  std::vector<ValueType> score(slots);
+  std::vector<uint64_t> hash(slots);
+  std::vector<uint32_t> ranked;
+  std::vector<uint32_t> freeSlots(slots);
+  ranked.reserve(slots);
+  for (std::size_t s = 0; s < slots; s++) {
+    freeSlots[s] = uint32_t(slots - 1 - s);
+  }
+
+  auto genome = [&](uint32_t slot) { return genes.data() + slot * length; };
+  PARTITION_STAT(SolveStats *stats = currentStats());
+  PARTITION_STAT(SolveStats counts);
+
+  // Scores the hashed genomes of batch: cache hits first, then the misses
+  std::unordered_map<uint64_t, ValueType> cache;
+  std::vector<uint32_t> misses;
+  auto scoreBatch = [&](const std::vector<uint32_t> &batch) {
+    misses.clear();
+    for (uint32_t slot : batch) {
+      auto it = cache.find(hash[slot]);
+      if (it != cache.end()) {
+        score[slot] = it->second;
+      } else {
+        misses.push_back(slot);
+      }
+    }
+    forEachGenome(misses.size(), length, settings.parallel,
+                  [&](std::size_t k) {
+                    score[misses[k]] = fitness(genome(misses[k]));
+                  });
+    for (uint32_t slot : misses) {
+      cache.emplace(hash[slot], score[slot]);
+    }
+    PARTITION_STAT(counts.evaluations += misses.size());
+    PARTITION_STAT(counts.cacheHits += batch.size() - misses.size());
+  };
+
+  // Ranks the scored slots of batch into the population, dropping the worst
+  auto merge = [&](const std::vector<uint32_t> &batch) {
+    for (uint32_t slot : batch) {
+      auto pos = std::upper_bound(
+          ranked.begin(), ranked.end(), score[slot],
+          [&](ValueType f, uint32_t other) { return f < score[other]; });
+      ranked.insert(pos, slot);
+      if (ranked.size() > settings.maxPopulation) {
+        freeSlots.push_back(ranked.back());
+        ranked.pop_back();
+      }
+    }
+  };
+
+  // --- População inicial ---
+  std::vector<uint32_t> batch;
+  for (std::size_t i = 0; i < settings.initialPopulation; i++) {
+    uint32_t slot = freeSlots.back();
+    freeSlots.pop_back();
+    init(i, genome(slot));
+    hash[slot] = hashGenome(genome(slot), length);
+    batch.push_back(slot);
+  }
+  scoreBatch(batch);
+  merge(batch);
+
+  // --- Evolução ---
+  std::vector<double> cumulative;
+  ValueType bestFitness = score[ranked.front()];
+  std::size_t generationsWithoutImprovement = 0;
+  bool interrupted = false;
+  control.report(start, bestFitness, target);
+  PARTITION_STAT(if (stats) stats->improved());
+
+  for (uint64_t generation = 0;
+       generationsWithoutImprovement < settings.maxStall; generation++) {
+    if (control.stopRequested()) {
+      interrupted = true;
+      break;
+    }
+    PARTITION_STAT(counts.generations++);
+
+    // Roulette over 1 / fitness, fixed for the whole generation
+    cumulative.resize(ranked.size());
+    double total = 0.0;
+    for (std::size_t i = 0; i < ranked.size(); i++) {
+      total += 1.0 / (double(score[ranked[i]]) + 1e-9);
+      cumulative[i] = total;
+    }
+    auto roulette = [&](SplitMix64 &rng) {
+      double r = std::uniform_real_distribution<double>(0.0, total)(rng);
+      auto it = std::upper_bound(cumulative.begin(), cumulative.end(), r);
+      return std::min<std::size_t>(it - cumulative.begin(), ranked.size() - 1);
+    };
+
+    const std::size_t offspringCount =
+        std::max<std::size_t>(1, ranked.size() / settings.crossoverFactor);
+    batch.clear();
+    for (std::size_t c = 0; c < offspringCount; c++) {
+      batch.push_back(freeSlots.back());
+      freeSlots.pop_back();
+    }
+
+    auto breedChild = [&](std::size_t c) {
+      SplitMix64 rng(streamSeed(seed, generation, c));
+      std::size_t p1 = roulette(rng);
+      std::size_t p2 = p1;
+      while (ranked.size() > 1 && p2 == p1) {
+        p2 = roulette(rng);
+      }
+
+      Gene *child = genome(batch[c]);
+      breed(genome(ranked[p1]), genome(ranked[p2]), child, rng);
+      hash[batch[c]] = hashGenome(child, length);
+    };
+    forEachGenome(offspringCount, length, settings.parallel, breedChild);
+    scoreBatch(batch);
+    merge(batch);
+
+    ValueType currentBest = score[ranked.front()];
+    if (currentBest < bestFitness) {
+      bestFitness = currentBest;
+      generationsWithoutImprovement = 0;
+      control.report(start, bestFitness, target);
+      PARTITION_STAT(if (stats) stats->improved());
+    } else {
+      ++generationsWithoutImprovement;
+    }
+
+    if (bestFitness == target) {
+      break;
+    }
+  }
+
+  PARTITION_STAT(if (stats) stats->add(counts));
+
+  const Gene *winner = genome(ranked.front());
+  best.assign(winner, winner + length);
+  return interrupted;
+}
+
+// Values of arr in decreasing order of their random keys, the order in which
+// geneticAlgorithm2 hands them to LS.
+void decodeKeys(const std::vector<ValueType> &arr, const double *keys,
+                std::vector<ItemIndex> &order, std::vector<ValueType> &values) {
+  order.resize(arr.size());
+  std::iota(order.begin(), order.end(), ItemIndex{0});
+  std::sort(order.begin(), order.end(),
+            [keys](ItemIndex a, ItemIndex b) { return keys[a] > keys[b]; });
+
+  values.resize(arr.size());
+  for (std::size_t k = 0; k < arr.size(); k++) {
+    values[k] = arr[order[k]];
+  }
+}
+
+// Runs geneticAlgorithm and writes the LS solution of its best genome into
+// out. Returns whether control stopped the search.
+bool geneticAssign(const std::vector<ValueType> &arr, std::size_t n,
+                   Assignment &out, const GeneticOptions &options,
+                   const SolveControl &control) {
+  if (n == 0) {
+    throw std::invalid_argument("n must be a positive integer");
+  }
+
+  // garante que population não está vazia
+  if (arr.empty()) {
+    LS(arr, n, out);
+    return false;
+  }
+
+  // -- Calcula o limite inferior do makespan --
+  const ValueType makespan_opt = makespanLowerBound(arr, n);
+  const std::size_t L = arr.size();
+
+  // RNG único: a população inicial e a semente das demais sequências
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+
+  // Genes: ids of distinct values, 0 for the largest. Equal values are
+  // interchangeable, so the multiset of the input is a count per id. The
+  // items of id d are byValue[first[d]], byValue[first[d] + 1], ...
+  std::vector<ItemIndex> byValue(L);
+  std::iota(byValue.begin(), byValue.end(), ItemIndex{0});
+  std::stable_sort(
+      byValue.begin(), byValue.end(),
+      [&arr](ItemIndex a, ItemIndex b) { return arr[a] > arr[b]; });
+  std::vector<ValueType> distinct;
+  std::vector<uint32_t> lpt(L);
+  std::vector<uint32_t> counts;
+  std::vector<uint32_t> first;
+  for (std::size_t k = 0; k < L; k++) {
+    if (k == 0 || arr[byValue[k]] != distinct.back()) {
+      distinct.push_back(arr[byValue[k]]);
+      counts.push_back(0);
+      first.push_back(uint32_t(k));
+    }
+    lpt[k] = uint32_t(counts.size() - 1);
+    counts.back()++;
+  }
+  const uint32_t EMPTY = std::numeric_limits<uint32_t>::max();
+
+  // --- População inicial: LPT e embaralhamentos sucessivos ---
+  auto init = [&](std::size_t i, uint32_t *genes) {
+    if (i > 0) {
+      std::shuffle(lpt.begin(), lpt.end(), gen);
+    }
+    std::copy(lpt.begin(), lpt.end(), genes);
+  };
+
+  // --- Crossover (uniform-like, preserva multiconjunto) e mutação ---
+  // O(L): quantos de cada valor ainda faltam no filho
+  auto breed = [&](const uint32_t *p1, const uint32_t *p2, uint32_t *child,
+                   SplitMix64 &rng) {
+    thread_local std::vector<uint32_t> available;
+    available.assign(counts.begin(), counts.end());
+
+    const size_t K = 2;
+
+    for (size_t start = 0; start < L; start += K) {
+      // define o bloco
+      size_t end = std::min(start + K, L);
+
+      // calcular diferenças dos blocos (ids crescem com valores menores)
+      uint32_t min1 = p1[start], max1 = p1[start];
+      uint32_t min2 = p2[start], max2 = p2[start];
+      for (size_t i = start + 1; i < end; ++i) {
+        min1 = std::min(min1, p1[i]);
+        max1 = std::max(max1, p1[i]);
+        min2 = std::min(min2, p2[i]);
+        max2 = std::max(max2, p2[i]);
+      }
+      ValueType diff1 = distinct[min1] - distinct[max1];
+      ValueType diff2 = distinct[min2] - distinct[max2];
+
+      // escolher bloco com menor diferença
+      const uint32_t *chosen = (diff1 <= diff2 ? p1 : p2);
+
+      // inserir deste bloco apenas valores disponíveis
+      for (size_t i = start; i < end; ++i) {
+        uint32_t id = chosen[i];
+        if (available[id] > 0) {
+          child[i] = id;
+          available[id]--;
+        } else {
+          child[i] = EMPTY;
+        }
+      }
+    }
+
+    // preencher os buracos com restantes, dos maiores para os menores
+    uint32_t next = 0;
+    for (size_t i = 0; i < L; ++i) {
+      if (child[i] != EMPTY) {
+        continue;
+      }
+      while (available[next] == 0) {
+        next++;
+      }
+      child[i] = next;
+      available[next]--;
+    }
+
+    // Mutação: inverte um trecho
+    std::uniform_int_distribution<size_t> idxDist(0, L - 1);
+    size_t a = idxDist(rng);
+    size_t b = idxDist(rng);
+    if (a > b)
+      std::swap(a, b);
+    std::reverse(child + a, child + b);
+  };
+
+  // Values of a genome, in the order LS takes them
+  auto decode = [&](const uint32_t *genes, std::vector<ValueType> &values) {
+    values.resize(L);
+    for (std::size_t k = 0; k < L; k++) {
+      values[k] = distinct[genes[k]];
+    }
+  };
+
+  auto fitness = [&](const uint32_t *genes) {
+    thread_local std::vector<ValueType> values;
+    decode(genes, values);
+    return lsMakespan(values.data(), L, n);
+  };
+
+  // --- Retorna solução LS do melhor indivíduo ---
+  std::vector<uint32_t> best;
+  GeneticSettings settings;
+  settings.parallel = options.parallel;
+  bool interrupted = evolve<uint32_t>(L, settings, makespan_opt, gen(), init,
+                                      breed, fitness, control, best);
+
+  // Every gene takes the next unused item of its value
+  std::vector<ValueType> values;
+  decode(best.data(), values);
+  std::vector<ItemIndex> order(L);
+  for (std::size_t k = 0; k < L; k++) {
+    order[k] = byValue[first[best[k]]++];
+  }
+  lsOrdered(values.data(), order.data(), L, n, out);
+  return interrupted;
+}
+
+// Max tree over the group loads: node p holds the most loaded group below it
+// (ties go left), leaves at leaves_ + g, so the makespan is read at the root
+// and a load change costs O(log n).
+class MaxLoadTree {
+public:
+  void reset(const std::vector<ValueType> &loads) {
+    leaves_ = 1;
+    while (leaves_ < loads.size()) {
+      leaves_ *= 2;
+    }
+
+    key_.assign(2 * leaves_, 0);
+    slot_.assign(2 * leaves_, 0);
+    for (std::size_t g = 0; g < loads.size(); g++) {
+      key_[leaves_ + g] = loads[g];
+      slot_[leaves_ + g] = GroupIndex(g);
+    }
+    for (std::size_t p = leaves_ - 1; p >= 1; p--) {
+      pull(p);
+    }
+  }
+
+  GroupIndex top() const { return slot_[1]; }
+  ValueType max() const { return key_[1]; }
+  ValueType load(GroupIndex g) const { return key_[leaves_ + g]; }
+
+  void set(GroupIndex g, ValueType load) {
+    std::size_t p = leaves_ + g;
+    key_[p] = load;
+    for (p /= 2; p >= 1; p /= 2) {
+      pull(p);
+    }
+  }
+
+private:
+  void pull(std::size_t p) {
+    std::size_t c = key_[2 * p + 1] > key_[2 * p] ? 2 * p + 1 : 2 * p;
+    key_[p] = key_[c];
+    slot_[p] = slot_[c];
+  }
+
+  std::size_t leaves_ = 1;
+  std::vector<ValueType> key_;
+  std::vector<GroupIndex> slot_;
+};
+
+// Candidate of simulated annealing: item goes to group to, and other comes
+// back from it when swap is set.
+struct Neighbour {
+  ItemIndex item;
+  GroupIndex to;
+  bool swap;
+  ItemIndex other;
+};
+
+/**
+ * @brief Solution under simulated annealing.
+ *
+ * Keeps the group of every item, the items of every group (with the position
+ * of each item in its list, for O(1) removal) and the loads in a max tree. A
+ * move or swap is scored by setting the two new loads and reading the root,
+ * and is applied in place or rolled back.
+ */
+class AnnealingState {
+public:
+  AnnealingState(const std::vector<ValueType> &arr, const Assignment &start)
+      : arr_(arr), groupOf_(start.groupOf), members_(start.loads.size()),
+        position_(arr.size()) {
+    for (std::size_t i = 0; i < arr.size(); i++) {
+      std::vector<ItemIndex> &list = members_[groupOf_[i]];
+      position_[i] = uint32_t(list.size());
+      list.push_back(ItemIndex(i));
+    }
+    tree_.reset(start.loads);
+  }
+
+  GroupIndex critical() const { return tree_.top(); }
+  ValueType makespan() const { return tree_.max(); }
+  ValueType load(GroupIndex g) const { return tree_.load(g); }
+  GroupIndex groupOf(ItemIndex item) const { return groupOf_[item]; }
+  std::size_t groups() const { return members_.size(); }
+  const std::vector<ItemIndex> &members(GroupIndex g) const {
+    return members_[g];
+  }
+
+  // Makespan once the neighbour is applied. The loads are left updated
+  // until it is accepted or rejected.
+  ValueType score(const Neighbour &nb) {
+    shift(nb, false);
+    return tree_.max();
+  }
+
+  // Rolls back the loads of a scored neighbour.
+  void reject(const Neighbour &nb) { shift(nb, true); }
+
+  // Commits the item lists of a scored neighbour.
+  void accept(const Neighbour &nb) {
+    GroupIndex from = groupOf_[nb.item];
+    if (nb.swap) {
+      std::swap(members_[from][position_[nb.item]],
+                members_[nb.to][position_[nb.other]]);
+      std::swap(position_[nb.item], position_[nb.other]);
+      groupOf_[nb.other] = from;
+    } else {
+      std::vector<ItemIndex> &source = members_[from];
+      ItemIndex last = source.back();
+      source[position_[nb.item]] = last;
+      position_[last] = position_[nb.item];
+      source.pop_back();
+      position_[nb.item] = uint32_t(members_[nb.to].size());
+      members_[nb.to].push_back(nb.item);
+    }
+    groupOf_[nb.item] = nb.to;
+  }
+
+  // Writes the current solution into out.
+  void save(Assignment &out) const {
+    out.groupOf = groupOf_;
+    for (std::size_t g = 0; g < out.loads.size(); g++) {
+      out.loads[g] = tree_.load(GroupIndex(g));
+    }
+    out.makespan = tree_.max();
+  }
+
+private:
+  const std::vector<ValueType> &arr_;
+  std::vector<GroupIndex> groupOf_;
+  std::vector<std::vector<ItemIndex>> members_;
+  std::vector<uint32_t> position_;
+  MaxLoadTree tree_;
+
+  void shift(const Neighbour &nb, bool undo) {
+    GroupIndex from = groupOf_[nb.item];
+    ValueType given = arr_[nb.item];
+    ValueType taken = nb.swap ? arr_[nb.other] : 0;
+    if (undo) {
+      std::swap(given, taken);
+    }
+    tree_.set(from, tree_.load(from) - given + taken);
+    tree_.set(nb.to, tree_.load(nb.to) - taken + given);
+  }
+};
+
+// State shared by the chains of one SimulatedAnnealing call: the best
+// makespan found by any of them, and the bound at which all of them stop.
+struct AnnealingShared {
+  std::atomic<ValueType> best;
+  ValueType lowerBound;
+  const SolveControl &control;
+  SolveControl::Clock::time_point start;
+  std::mutex mutex;                  // serializes updates of best
+  std::atomic<bool> interrupted{false}; // the control asked to stop
+  SolveStats *stats = currentStats();   // of the caller's scope, may be null
+
+  AnnealingShared(ValueType best, ValueType lowerBound,
+                  const SolveControl &control,
+                  SolveControl::Clock::time_point start)
+      : best(best), lowerBound(lowerBound), control(control), start(start) {}
+
+  // Publishes the best makespan of a chain.
+  void offer(ValueType makespan) {
+    if (makespan >= best.load()) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    if (makespan < best.load()) {
+      best.store(makespan);
+      control.report(start, makespan, lowerBound);
+      PARTITION_STAT(if (stats) stats->improved());
+    }
+  }
+};
+
+// Runs one annealing chain from the solution in out, with its starting
+// temperature scaled by heat, and leaves the best solution it found in out.
+// Returns the temperature the chain stopped at.
+double annealChain(const std::vector<ValueType> &arr, std::size_t n,
+                 double heat, SplitMix64 gen, AnnealingShared &shared,
+                 Assignment &out) {
+  // --- 1. Configuração ---
+  // Ajuste: Temperatura baseada na média dos dados para ser adaptável
+  double avgVal = std::accumulate(arr.begin(), arr.end(), 0.0) / arr.size();
+
+  double temperature =
+      avgVal * 0.5 * heat; // Começa aceitando pioras de ~50% de um job médio
+  const double coolingRate = 0.95; // Resfriamento mais lento (95%)
+  // Um vizinho custa O(log n), então cada temperatura tenta tantos vizinhos
+  // quanto itens (no mínimo 10)
+  const std::size_t neighborsPerTemp = std::max<std::size_t>(10, arr.size());
+
+  std::uniform_real_distribution<> dist01(0.0, 1.0);
+  std::uniform_int_distribution<std::size_t> distMachine(0, n - 1);
+
+  AnnealingState state(arr, out);
+  ValueType currentMakespan = state.makespan();
+  ValueType bestMakespan = currentMakespan;
+
+  // --- 2. Loop Principal ---
+  int iterationsWithoutImprovement = 0;
+  int maxTotalIterations = 5000;
+  int iter = 0;
+  PARTITION_STAT(SolveStats counts);
+
+  while (temperature > 0.1 && iter < maxTotalIterations) {
+
+    for (std::size_t i = 0; i < neighborsPerTemp; ++i) {
+
+      // A. Identificar Máquina Crítica (Gargalo)
+      GroupIndex maxMachineIdx = state.critical();
+      const auto &source = state.members(maxMachineIdx);
+      if (source.empty())
+        continue;
+
+      // B. Selecionar Job da Máquina Crítica
+      ItemIndex job = source[std::uniform_int_distribution<std::size_t>(
+          0, source.size() - 1)(gen)];
+
+      // C. Selecionar Máquina Destino Aleatória
+      std::size_t targetMachineIdx = distMachine(gen);
+      while (targetMachineIdx == maxMachineIdx) {
+        targetMachineIdx = distMachine(gen);
+      }
+
+      // D. ESTRATÉGIA DE LAHA: SWAP (Troca) se possível, senão MOVE
+      Neighbour nb{job, GroupIndex(targetMachineIdx), false, 0};
+      const auto &target = state.members(nb.to);
+      if (!target.empty()) {
+        nb.swap = true;
+        nb.other = target[std::uniform_int_distribution<std::size_t>(
+            0, target.size() - 1)(gen)];
+      }
+
+      // Avaliação
+      ValueType neighborMakespan = state.score(nb);
+      PARTITION_STAT(counts.proposed++);
+      double delta = double(neighborMakespan) - double(currentMakespan);
+
+      bool accept = false;
+      if (delta < 0) {
+        accept = true;
+      } else {
+        // Critério de Metropolis
+        if (dist01(gen) < std::exp(-delta / temperature)) {
+          accept = true;
+        }
+      }
+
+      if (!accept) {
+        state.reject(nb);
+        continue;
+      }
+
+      state.accept(nb);
+      PARTITION_STAT(counts.accepted++);
+      currentMakespan = neighborMakespan; // Atualiza custo atual
+
+      if (currentMakespan < bestMakespan) {
+        state.save(out);
+        bestMakespan = currentMakespan;
+        iterationsWithoutImprovement = 0;
+
+        shared.offer(bestMakespan);
+      }
+    }
+
+    // Nenhuma cadeia pode passar do limite inferior
+    if (shared.best.load(std::memory_order_relaxed) <= shared.lowerBound)
+      break;
+
+    if (shared.interrupted.load(std::memory_order_relaxed) ||
+        shared.control.stopRequested()) {
+      shared.interrupted.store(true, std::memory_order_relaxed);
+      break;
+    }
+
+    iterationsWithoutImprovement++;
+    if (iterationsWithoutImprovement > 50)
+      break; // Critério de parada antecipada
+
+    temperature *= coolingRate;
+    iter++;
+  }
+
+  PARTITION_STAT(if (shared.stats) shared.stats->add(counts));
+  return temperature;
+}
+
+SolveStatus annealingAssign(const std::vector<ValueType> &arr, std::size_t n,
+                            Assignment &out, const AnnealingOptions &options,
+                            const SolveControl &control) {
+  if (n == 0) {
+    throw std::invalid_argument("n must be a positive integer");
+  }
+  const auto start = SolveControl::Clock::now();
+
+  // --- Solução Inicial ---
+  LPT(arr, n, out);
+  const ValueType lowerBound = makespanLowerBound(arr, n);
+  control.report(start, out.makespan, lowerBound);
+  AnnealingShared shared(out.makespan, lowerBound, control, start);
+  PARTITION_STAT(if (shared.stats) shared.stats->improved());
+  if (n == 1 || out.makespan <= lowerBound) {
+    return heuristicStatus(arr, n, out, false);
+  }
+
+  uint64_t seed = options.seed;
+  if (seed == 0) {
+    std::random_device rd;
+    seed = (uint64_t(rd()) << 32) | rd();
+  }
+
+  ThreadPool &pool = ThreadPool::shared();
+  const std::size_t chains = options.chains ? options.chains : pool.size();
+  SolveStats winnerStats; // final temperature of the chain returned
+  if (chains == 1) {
+    winnerStats.finalTemperature = annealChain(
+        arr, n, 1.0, SplitMix64(streamSeed(seed, 0, 0)), shared, out);
+    PARTITION_STAT(if (shared.stats) shared.stats->add(winnerStats));
+    return heuristicStatus(arr, n, out, shared.interrupted);
+  }
+
+  // Chain 0 keeps the default schedule; the others start log-uniformly
+  // between a quarter and four times its temperature
+  std::vector<Assignment> results(chains, out);
+  std::vector<double> temperatures(chains);
+  pool.parallelFor(chains, [&](std::size_t c) {
+    double heat =
+        c == 0 ? 1.0
+               : std::pow(4.0, 2.0 * double(c - 1) /
+                                       double(std::max<std::size_t>(
+                                           1, chains - 2)) -
+                                   1.0);
+    temperatures[c] = annealChain(arr, n, heat,
+                                  SplitMix64(streamSeed(seed, 0, c)), shared,
+                                  results[c]);
+  });
+
+  std::size_t winner = 0;
+  for (std::size_t c = 1; c < chains; c++) {
+    if (results[c].makespan < results[winner].makespan) {
+      winner = c;
+    }
+  }
+  std::swap(out, results[winner]);
+  winnerStats.finalTemperature = temperatures[winner];
+  PARTITION_STAT(if (shared.stats) shared.stats->add(winnerStats));
+  return heuristicStatus(arr, n, out, shared.interrupted);
+}
+
+/**
+ * @brief Annealing state of a rebalance, which also knows the group every
+ * item started in.
+ *
+ * A plan costs makespan + moveCost * migrations, where the migrations are
+ * the items outside their starting group; an item that goes back home stops
+ * counting.
+ */
+class MigrationState : public AnnealingState {
+public:
+  MigrationState(const std::vector<ValueType> &arr, const Assignment &start,
+                 const std::vector<GroupIndex> &home, ValueType moveCost)
+      : AnnealingState(arr, start), home_(home), moveCost_(moveCost) {
+    for (std::size_t i = 0; i < home.size(); i++) {
+      away_ += start.groupOf[i] != home[i];
+    }
+  }
+
+  std::size_t away() const { return away_; }
+  GroupIndex home(ItemIndex item) const { return home_[item]; }
+
+  // Migrations once nb is applied.
+  std::size_t awayAfter(const Neighbour &nb) const {
+    GroupIndex from = groupOf(nb.item);
+    std::size_t away = away_;
+    away += nb.to != home_[nb.item];
+    away -= from != home_[nb.item];
+    if (nb.swap) {
+      away += from != home_[nb.other];
+      away -= nb.to != home_[nb.other];
+    }
+    return away;
+  }
+
+  ValueType cost(ValueType makespan, std::size_t away) const {
+    return makespan + moveCost_ * away;
+  }
+  ValueType cost() const { return cost(makespan(), away_); }
+
+  void accept(const Neighbour &nb) {
+    away_ = awayAfter(nb);
+    AnnealingState::accept(nb);
+  }
+
+private:
+  const std::vector<GroupIndex> &home_;
+  ValueType moveCost_;
+  std::size_t away_ = 0;
+};
+
+// Makespan no plan within budget can beat: besides the bound of any
+// partition, every group keeps at least its load minus its budget largest
+// items.
+ValueType migrationLowerBound(const std::vector<ValueType> &arr,
+                              const Assignment &start, std::size_t budget) {
+  ValueType bound = makespanLowerBound(arr, start.loads.size());
+  Groups groups = toGroups(arr, start);
+  for (std::size_t g = 0; g < groups.size(); g++) {
+    std::vector<ValueType> &group = groups[g];
+    std::size_t shed = std::min(budget, group.size());
+    std::partial_sort(group.begin(), group.begin() + shed, group.end(),
+                      std::greater<ValueType>());
+    ValueType kept = std::accumulate(group.begin() + shed, group.end(),
+                                     ValueType{0});
+    bound = std::max(bound, kept);
+  }
+  return bound;
+}
+
+// Descent out of the heaviest group: every step applies the move of one of
+// its items to the lightest group, or the swap with one item of it, that
+// lowers the cost most (the two loads closest on ties). Only changes that
+// leave both loads below the old maximum are tried, so the sum of squared
+// loads drops at each step and the descent ends. Returns whether control
+// stopped it.
+bool migrationDescent(const std::vector<ValueType> &arr, std::size_t n,
+                      MigrationState &state, std::size_t budget,
+                      ValueType lowerBound, const SolveControl &control) {
+  std::vector<ItemIndex> light; // lightest group by increasing value
+  while (state.makespan() > lowerBound) {
+    if (control.stopRequested()) {
+      return true;
+    }
+    const GroupIndex high = state.critical();
+    GroupIndex low = 0;
+    for (GroupIndex g = 1; g < n; g++) {
+      if (state.load(g) < state.load(low)) {
+        low = g;
+      }
+    }
+    const ValueType gap = state.load(high) - state.load(low);
+
+    ValueType bestCost = state.cost();
+    ValueType bestSpread = gap;
+    Neighbour best{0, low, false, 0};
+    auto consider = [&](const Neighbour &nb, ValueType delta) {
+      std::size_t away = state.awayAfter(nb);
+      if (away > budget) {
+        return;
+      }
+      ValueType cost = state.cost(state.score(nb), away);
+      state.reject(nb);
+      ValueType spread = gap > 2 * delta ? gap - 2 * delta : 2 * delta - gap;
+      if (cost < bestCost || (cost == bestCost && spread < bestSpread)) {
+        bestCost = cost;
+        bestSpread = spread;
+        best = nb;
+      }
+    };
+
+    light = state.members(low);
+    std::sort(light.begin(), light.end(),
+              [&arr](ItemIndex a, ItemIndex b) { return arr[a] < arr[b]; });
+    for (ItemIndex a : state.members(high)) {
+      if (arr[a] < gap) {
+        consider(Neighbour{a, low, false, 0}, arr[a]);
+      }
+      // Items b of the light group around arr[a] - gap / 2
+      ValueType ideal = arr[a] > gap / 2 ? arr[a] - gap / 2 : 0;
+      auto it = std::lower_bound(
+          light.begin(), light.end(), ideal,
+          [&arr](ItemIndex b, ValueType v) { return arr[b] < v; });
+      for (auto c = it == light.begin() ? it : it - 1;
+           c != light.end() && c <= it; ++c) {
+        if (arr[*c] < arr[a] && arr[a] - arr[*c] < gap) {
+          consider(Neighbour{a, low, true, *c}, arr[a] - arr[*c]);
+        }
+      }
+    }
+
+    if (bestSpread == gap) {
+      break; // no change within the budget pays off
+    }
+    state.score(best);
+    state.accept(best);
+  }
+  return false;
+}
+
+// Anneals a rebalance from the plan in out over the moves and swaps of
+// SimulatedAnnealing, never going past the budget, and leaves the cheapest
+// plan found in out. Returns whether control stopped it.
+bool migrationAnneal(const std::vector<ValueType> &arr, std::size_t n,
+                     const std::vector<GroupIndex> &home,
+                     const MigrationOptions &options, ValueType lowerBound,
+                     SplitMix64 gen, const SolveControl &control,
+                     SolveControl::Clock::time_point start, Assignment &out) {
+  double avgVal = std::accumulate(arr.begin(), arr.end(), 0.0) / arr.size();
+  double temperature = avgVal * 0.5;
+  const double coolingRate = 0.95;
+  const std::size_t neighborsPerTemp = std::max<std::size_t>(10, arr.size());
+
+  std::uniform_real_distribution<> dist01(0.0, 1.0);
+  std::uniform_int_distribution<std::size_t> distMachine(0, n - 1);
+
+  MigrationState state(arr, out, home, options.moveCost);
+  ValueType currentCost = state.cost();
+  ValueType bestCost = currentCost;
+  std::size_t bestAway = state.away();
+
+  int iterationsWithoutImprovement = 0;
+  bool interrupted = false;
+  PARTITION_STAT(SolveStats *stats = currentStats());
+  PARTITION_STAT(SolveStats counts);
+
+  for (int iter = 0; temperature > 0.1 && iter < 5000; iter++) {
+    for (std::size_t i = 0; i < neighborsPerTemp; ++i) {
+      GroupIndex from = state.critical();
+      const auto &source = state.members(from);
+      if (source.empty())
+        continue;
+      ItemIndex job = source[std::uniform_int_distribution<std::size_t>(
+          0, source.size() - 1)(gen)];
+      std::size_t to = distMachine(gen);
+      while (to == from) {
+        to = distMachine(gen);
+      }
+
+      // Moves as well as swaps: a move is the cheapest way to shed load
+      Neighbour nb{job, GroupIndex(to), false, 0};
+      const auto &target = state.members(nb.to);
+      if (!target.empty() && dist01(gen) < 0.5) {
+        nb.swap = true;
+        nb.other = target[std::uniform_int_distribution<std::size_t>(
+            0, target.size() - 1)(gen)];
+      }
+      std::size_t away = state.awayAfter(nb);
+      if (away > options.budget) {
+        continue;
+      }
+
+      ValueType cost = state.cost(state.score(nb), away);
+      PARTITION_STAT(counts.proposed++);
+      double delta = double(cost) - double(currentCost);
+      if (delta >= 0 && dist01(gen) >= std::exp(-delta / temperature)) {
+        state.reject(nb);
+        continue;
+      }
+      state.accept(nb);
+      PARTITION_STAT(counts.accepted++);
+      currentCost = cost;
+
+      if (cost < bestCost || (cost == bestCost && away < bestAway)) {
+        if (state.makespan() < out.makespan) {
+          control.report(start, state.makespan(), lowerBound);
+          PARTITION_STAT(if (stats) stats->improved());
+        }
+        state.save(out);
+        bestCost = cost;
+        bestAway = away;
+        iterationsWithoutImprovement = 0;
+      }
+    }
+
+    if (out.makespan <= lowerBound)
+      break;
+    if (control.stopRequested()) {
+      interrupted = true;
+      break;
+    }
+    if (++iterationsWithoutImprovement > 50)
+      break;
+    temperature *= coolingRate;
+  }
+
+  PARTITION_STAT(if (stats) stats->add(counts));
+  return interrupted;
+}
+
+// Sends migrated items back to their starting group, alone or swapped with
+// an item that also went away from that group, whenever the plan gets no
+// costlier.
+void returnHome(MigrationState &state) {
+  std::vector<ItemIndex> away;
+  for (bool changed = true; changed;) {
+    changed = false;
+    away.clear();
+    for (GroupIndex g = 0; g < state.groups(); g++) {
+      for (ItemIndex i : state.members(g)) {
+        if (g != state.home(i)) {
+          away.push_back(i);
+        }
+      }
+    }
+    std::sort(away.begin(), away.end());
+
+    for (std::size_t k = 0; k < away.size(); k++) {
+      ItemIndex i = away[k];
+      if (state.groupOf(i) == state.home(i)) {
+        continue;
+      }
+      Neighbour back{i, state.home(i), false, 0};
+      ValueType cost = state.cost();
+      if (state.cost(state.score(back), state.awayAfter(back)) <= cost) {
+        state.accept(back);
+        changed = true;
+        continue;
+      }
+      state.reject(back);
+      for (std::size_t l = k + 1; l < away.size(); l++) {
+        ItemIndex j = away[l];
+        if (state.groupOf(j) != state.home(i) ||
+            state.home(j) != state.groupOf(i)) {
+          continue;
+        }
+        Neighbour pair{i, state.home(i), true, j};
+        if (state.cost(state.score(pair), state.awayAfter(pair)) <= cost) {
+          state.accept(pair);
+          changed = true;
+          break;
+        }
+        state.reject(pair);
+      }
+    }
+  }
+}
+
+// Runs geneticAlgorithm2 and writes the LS solution of its best genome into
+// out. Returns whether control stopped the search.
+bool geneticAssign2(const std::vector<ValueType> &arr, std::size_t n,
+                    Assignment &out, const GeneticOptions &options,
+                    const SolveControl &control) {
+  if (n == 0) {
+    throw std::invalid_argument("n must be a positive integer");
+  }
+
+  // garante que population não está vazia
+  if (arr.empty()) {
+    LS(arr, n, out);
+    return false;
+  }
+
+  // --- Constantes ---
+  const int MUTATION_PROBABILITY = 40; // percentage
+  const double MUTATION_STRENGTH = 0.1;
+
+  // -- Calcula o limite inferior do makespan --
+  const ValueType makespan_opt = makespanLowerBound(arr, n);
+  const std::size_t L = arr.size();
+
+  // RNG único: a população inicial e a semente das demais sequências
+  std::random_device rd;
+  std::mt19937_64 gen(rd());
+  std::uniform_real_distribution<double> dist01(0.0, 1.0);
+
+  // Genes: uma chave por item, na ordem dos itens, para que o crossover
+  // misture chaves do mesmo item. Os itens vão ao LS em ordem decrescente
+  // de chave.
+  auto init = [&](std::size_t i, double *keys) {
+    if (i > 0) {
+      for (std::size_t k = 0; k < L; k++) {
+        keys[k] = dist01(gen);
+      }
+      return;
+    }
+
+    // --- Primeiro indivíduo (Ordenado) ---
+    std::vector<ItemIndex> items(L);
+    std::iota(items.begin(), items.end(), ItemIndex{0});
+    std::sort(items.begin(), items.end(),
+              [&arr](ItemIndex a, ItemIndex b) { return arr[a] < arr[b]; });
+    double increment = 1.0 / L;
+    for (std::size_t k = 0; k < L; k++) {
+      keys[items[k]] = k * increment;
+    }
+  };
+
+  // --- Crossover (alterna os pais) e mutação das chaves ---
+  auto breed = [&](const double *p1, const double *p2, double *child,
+                   SplitMix64 &rng) {
+    for (size_t i = 0; i < L; i++) {
+      child[i] = i % 2 == 0 ? p1[i] : p2[i];
+    }
+
+    std::uniform_int_distribution<int> distPercent(0, 99);
+    std::uniform_real_distribution<double> distMutation(-MUTATION_STRENGTH,
+                                                        MUTATION_STRENGTH);
+    std::uniform_int_distribution<size_t> idxDist(0, L - 1);
+    while (distPercent(rng) < MUTATION_PROBABILITY) {
+      size_t idx = idxDist(rng);
+      child[idx] = std::clamp(child[idx] + distMutation(rng), 0.0, 1.0);
+    }
+  };
+
+  auto fitness = [&](const double *keys) {
+    thread_local std::vector<ItemIndex> order;
+    thread_local std::vector<ValueType> values;
+    decodeKeys(arr, keys, order, values);
+    return lsMakespan(values.data(), L, n);
+  };
+
+  // --- Retorna solução LS do melhor indivíduo ---
+  std::vector<double> best;
+  GeneticSettings settings;
+  settings.parallel = options.parallel;
+  bool interrupted = evolve<double>(L, settings, makespan_opt, gen(), init,
+                                    breed, fitness, control, best);
+
+  std::vector<ItemIndex> order;
+  std::vector<ValueType> values;
+  decodeKeys(arr, best.data(), order, values);
+  lsOrdered(values.data(), order.data(), L, n, out);
+  return interrupted;
+}
+} // namespace
+
+void geneticAlgorithm(const std::vector<ValueType> &arr, std::size_t n,
+                      Assignment &out) {
+  geneticAlgorithm(arr, n, out, SolveControl{});
+}
+
+SolveStatus geneticAlgorithm(const std::vector<ValueType> &arr, std::size_t n,
+                             Assignment &out, const SolveControl &control) {
+  return geneticAlgorithm(arr, n, out, GeneticOptions{}, control);
+}
+
+SolveStatus geneticAlgorithm(const std::vector<ValueType> &arr, std::size_t n,
+                             Assignment &out, const GeneticOptions &options,
+                             const SolveControl &control) {
+  bool interrupted = geneticAssign(arr, n, out, options, control);
+  return heuristicStatus(arr, n, out, interrupted);
+}
+
+void geneticAlgorithm2(const std::vector<ValueType> &arr, std::size_t n,
+                       Assignment &out) {
+  geneticAlgorithm2(arr, n, out, SolveControl{});
+}
+
+SolveStatus geneticAlgorithm2(const std::vector<ValueType> &arr,
+                              std::size_t n, Assignment &out,
+                              const SolveControl &control) {
+  return geneticAlgorithm2(arr, n, out, GeneticOptions{}, control);
+}
+
+SolveStatus geneticAlgorithm2(const std::vector<ValueType> &arr,
+                              std::size_t n, Assignment &out,
+                              const GeneticOptions &options,
+                              const SolveControl &control) {
+  bool interrupted = geneticAssign2(arr, n, out, options, control);
+  return heuristicStatus(arr, n, out, interrupted);
+}
+
+void SimulatedAnnealing(const std::vector<ValueType> &arr, std::size_t n,
+                        Assignment &out) {
+  annealingAssign(arr, n, out, AnnealingOptions{}, SolveControl{});
+}
+
+void SimulatedAnnealing(const std::vector<ValueType> &arr, std::size_t n,
+                        Assignment &out, const AnnealingOptions &options) {
+  annealingAssign(arr, n, out, options, SolveControl{});
+}
+
+SolveStatus SimulatedAnnealing(const std::vector<ValueType> &arr,
+                               std::size_t n, Assignment &out,
+                               const AnnealingOptions &options,
+                               const SolveControl &control) {
+  return annealingAssign(arr, n, out, options, control);
+}
+
+SolveStatus rebalance(const std::vector<ValueType> &arr,
+                      const Assignment &current, std::vector<Migration> &moves,
+                      const MigrationOptions &options,
+                      const SolveControl &control) {
+  const std::size_t n = current.loads.size();
+  if (n == 0) {
+    throw std::invalid_argument("current must have at least one group");
+  }
+  if (current.groupOf.size() != arr.size()) {
+    throw std::invalid_argument("current must assign every item");
+  }
+  const auto start = SolveControl::Clock::now();
+
+  // The loads are recomputed, so a stale current.loads does not matter
+  Assignment plan;
+  plan.groupOf = current.groupOf;
+  plan.loads.assign(n, 0);
+  for (std::size_t i = 0; i < arr.size(); i++) {
+    if (plan.groupOf[i] >= n) {
+      throw std::invalid_argument("current assigns an item to no group");
+    }
+    plan.loads[plan.groupOf[i]] += arr[i];
+  }
+  plan.makespan = *std::max_element(plan.loads.begin(), plan.loads.end());
+
+  SolveStatus status;
+  status.lowerBound = migrationLowerBound(arr, plan, options.budget);
+  control.report(start, plan.makespan, status.lowerBound);
+  PARTITION_STAT(if (SolveStats *stats = currentStats()) stats->improved());
+
+  if (plan.makespan > status.lowerBound) {
+    MigrationState state(arr, plan, current.groupOf, options.moveCost);
+    status.interrupted = migrationDescent(arr, n, state, options.budget,
+                                          status.lowerBound, control);
+    if (state.makespan() < plan.makespan) {
+      control.report(start, state.makespan(), status.lowerBound);
+      PARTITION_STAT(if (SolveStats *stats = currentStats()) stats->improved());
+    }
+    state.save(plan);
+
+    if (!status.interrupted && plan.makespan > status.lowerBound) {
+      uint64_t seed = options.seed;
+      if (seed == 0) {
+        std::random_device rd;
+        seed = (uint64_t(rd()) << 32) | rd();
+      }
+      status.interrupted = migrationAnneal(
+          arr, n, current.groupOf, options, status.lowerBound,
+          SplitMix64(streamSeed(seed, 0, 0)), control, start, plan);
+    }
+
+    MigrationState cleanup(arr, plan, current.groupOf, options.moveCost);
+    returnHome(cleanup);
+    cleanup.save(plan);
+  }
+
+  moves.clear();
+  for (std::size_t i = 0; i < arr.size(); i++) {
+    if (plan.groupOf[i] != current.groupOf[i]) {
+      moves.push_back({ItemIndex(i), current.groupOf[i], plan.groupOf[i]});
+    }
+  }
+  status.optimal = plan.makespan <= status.lowerBound;
+  status.interrupted = status.interrupted && !status.optimal;
+  return status;
+}
+
+Groups geneticAlgorithm(const std::vector<ValueType> &arr, std::size_t n) {
+  Assignment assignment;
+  geneticAlgorithm(arr, n, assignment);
+  return toGroups(arr, assignment);
+}
+
+Groups geneticAlgorithm2(const std::vector<ValueType> &arr, std::size_t n) {
+  Assignment assignment;
+  geneticAlgorithm2(arr, n, assignment);
+  return toGroups(arr, assignment);
+}
+
+Groups SimulatedAnnealing(const std::vector<ValueType> &arr, std::size_t n) {
+  Assignment assignment;
+  SimulatedAnnealing(arr, n, assignment);
+  return toGroups(arr, assignment);
+}
+} // namespace partition
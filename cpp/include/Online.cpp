@@ -0,0 +1,196 @@
+#include "Partition.hpp"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace partition {
+
+namespace {
+// Group of an id that is not a live item.
+constexpr GroupIndex NO_GROUP = std::numeric_limits<GroupIndex>::max();
+
+// Distance between the loads a change of delta leaves on the heaviest
+// (load high) and the lightest (load low) group. Smaller is more balanced.
+ValueType spread(ValueType high, ValueType low, ValueType delta) {
+  ValueType a = high - delta;
+  ValueType b = low + delta;
+  return a > b ? a - b : b - a;
+}
+} // namespace
+
+OnlinePartitioner::OnlinePartitioner(std::size_t n) {
+  if (n == 0) {
+    throw std::invalid_argument("n must be a positive integer");
+  }
+  members_.resize(n);
+
+  while (leaves_ < n) {
+    leaves_ *= 2;
+  }
+
+  // Padding leaves never win: they are the heaviest for the min side and the
+  // lightest for the max side
+  minKey_.assign(2 * leaves_, std::numeric_limits<ValueType>::max());
+  maxKey_.assign(2 * leaves_, 0);
+  minSlot_.assign(2 * leaves_, 0);
+  maxSlot_.assign(2 * leaves_, 0);
+  for (std::size_t j = 0; j < leaves_; j++) {
+    if (j < n) {
+      minKey_[leaves_ + j] = 0;
+    }
+    minSlot_[leaves_ + j] = maxSlot_[leaves_ + j] = GroupIndex(j);
+  }
+  for (std::size_t p = leaves_ - 1; p >= 1; p--) {
+    minKey_[p] = minKey_[2 * p];
+    minSlot_[p] = minSlot_[2 * p];
+    maxKey_[p] = maxKey_[2 * p];
+    maxSlot_[p] = maxSlot_[2 * p];
+  }
+}
+
+void OnlinePartitioner::setLoad(GroupIndex g, ValueType load) {
+  std::size_t p = leaves_ + g;
+  minKey_[p] = maxKey_[p] = load;
+  for (p /= 2; p >= 1; p /= 2) {
+    // The left child wins ties on both sides
+    std::size_t lo = minKey_[2 * p + 1] < minKey_[2 * p] ? 2 * p + 1 : 2 * p;
+    std::size_t hi = maxKey_[2 * p + 1] > maxKey_[2 * p] ? 2 * p + 1 : 2 * p;
+    minKey_[p] = minKey_[lo];
+    minSlot_[p] = minSlot_[lo];
+    maxKey_[p] = maxKey_[hi];
+    maxSlot_[p] = maxSlot_[hi];
+  }
+}
+
+void OnlinePartitioner::place(ItemIndex item, GroupIndex g) {
+  std::vector<ItemIndex> &list = members_[g];
+  groupOf_[item] = g;
+  position_[item] = uint32_t(list.size());
+  list.push_back(item);
+  setLoad(g, load(g) + values_[item]);
+}
+
+void OnlinePartitioner::unplace(ItemIndex item) {
+  GroupIndex g = groupOf_[item];
+  std::vector<ItemIndex> &list = members_[g];
+  ItemIndex last = list.back();
+  list[position_[item]] = last;
+  position_[last] = position_[item];
+  list.pop_back();
+  groupOf_[item] = NO_GROUP;
+  setLoad(g, load(g) - values_[item]);
+}
+
+void OnlinePartitioner::checkLive(ItemIndex item) const {
+  if (item >= groupOf_.size() || groupOf_[item] == NO_GROUP) {
+    throw std::out_of_range("not a live item");
+  }
+}
+
+OnlinePartitioner::Placement OnlinePartitioner::add(ValueType value) {
+  ItemIndex item;
+  if (!freeIds_.empty()) {
+    item = freeIds_.back();
+    freeIds_.pop_back();
+    values_[item] = value;
+  } else {
+    item = ItemIndex(values_.size());
+    values_.push_back(value);
+    groupOf_.push_back(NO_GROUP);
+    position_.push_back(0);
+  }
+
+  GroupIndex g = minSlot_[1];
+  place(item, g);
+  return {item, g};
+}
+
+void OnlinePartitioner::remove(ItemIndex item) {
+  checkLive(item);
+  unplace(item);
+  freeIds_.push_back(item);
+}
+
+GroupIndex OnlinePartitioner::groupOf(ItemIndex item) const {
+  checkLive(item);
+  return groupOf_[item];
+}
+
+ValueType OnlinePartitioner::value(ItemIndex item) const {
+  checkLive(item);
+  return values_[item];
+}
+
+std::size_t OnlinePartitioner::rebalance(std::size_t budget) {
+  std::size_t moved = 0;
+  std::vector<ItemIndex> light; // lightest group by increasing value
+
+  for (std::size_t step = 0; step < budget; step++) {
+    const GroupIndex high = maxSlot_[1];
+    const GroupIndex low = minSlot_[1];
+    const ValueType highLoad = load(high);
+    const ValueType lowLoad = load(low);
+    const ValueType gap = highLoad - lowLoad;
+    if (high == low || gap <= 1) {
+      break;
+    }
+
+    // A change of delta in (0, gap) lowers the heavier load and keeps the
+    // lighter one below the old maximum; the best one is closest to gap / 2
+    ValueType bestSpread = gap;
+    ItemIndex bestItem = 0, bestOther = 0;
+    bool swap = false;
+
+    for (ItemIndex a : members_[high]) {
+      if (values_[a] >= gap) {
+        continue;
+      }
+      ValueType s = spread(highLoad, lowLoad, values_[a]);
+      if (s < bestSpread) {
+        bestSpread = s;
+        bestItem = a;
+      }
+    }
+
+    light.assign(members_[low].begin(), members_[low].end());
+    std::sort(light.begin(), light.end(), [this](ItemIndex a, ItemIndex b) {
+      return values_[a] < values_[b];
+    });
+    for (ItemIndex a : members_[high]) {
+      const ValueType va = values_[a];
+      // Items b of the light group around va - gap / 2 with 0 < va - b < gap
+      ValueType ideal = va > gap / 2 ? va - gap / 2 : 0;
+      auto it = std::lower_bound(
+          light.begin(), light.end(), ideal,
+          [this](ItemIndex b, ValueType v) { return values_[b] < v; });
+      for (auto c = it == light.begin() ? it : it - 1;
+           c != light.end() && c <= it; ++c) {
+        const ValueType vb = values_[*c];
+        if (vb >= va || va - vb >= gap) {
+          continue;
+        }
+        ValueType s = spread(highLoad, lowLoad, va - vb);
+        if (s < bestSpread) {
+          bestSpread = s;
+          bestItem = a;
+          bestOther = *c;
+          swap = true;
+        }
+      }
+    }
+
+    if (bestSpread == gap) {
+      break; // no change keeps both loads below the maximum
+    }
+    unplace(bestItem);
+    place(bestItem, low);
+    moved++;
+    if (swap) {
+      unplace(bestOther);
+      place(bestOther, high);
+      moved++;
+    }
+  }
+  return moved;
+}
+} // namespace partition
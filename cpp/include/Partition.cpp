@@ -1,36 +1,1117 @@
 #include "Partition.hpp"
+#include "ThreadPool.hpp"
+#include <atomic>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
 
 namespace partition {
-std::vector<std::vector<ValueType>> FFD(std::vector<ValueType> &arr,
-                                        ValueType capacity) {
-  struct Bin {
-    ValueType remaining;
-    std::size_t idx;
-    bool operator<(const Bin &other) const {
-      return remaining < other.remaining;
+
+namespace {
+// Per-thread scratch buffers, reused across calls so that repeated solves do
+// not allocate once they reached their largest size.
+struct Workspace {
+  std::vector<ItemIndex> order;     // items in decreasing order of value
+  std::vector<ValueType> sorted;    // values in decreasing order
+  std::vector<GroupIndex> bestBins; // group of each sorted item
+  std::vector<ValueType> cgaLoads;   // CGA loads, increasing
+  std::vector<GroupIndex> cgaGroupAt; // CGA group of each load slot
+  std::vector<GroupIndex> current;    // CGA partial assignment
+  std::vector<uint32_t> cgaNext;      // CGA next slot to try, per depth
+  std::vector<uint32_t> cgaFrom;      // CGA slot an item was added to
+  std::vector<uint32_t> cgaTo;        // CGA slot that load moved to
+  std::vector<ValueType> kkLoads;     // KK loads of the stored tuples
+  std::vector<uint32_t> kkSets;       // KK item list of each tuple slot
+  std::vector<uint32_t> kkNext;       // KK next item of each item list
+  std::vector<uint32_t> kkTail;       // KK last item of each item list
+  std::vector<uint32_t> kkFree;       // KK stored tuples free for reuse
+  std::vector<std::pair<ValueType, uint32_t>> kkHeap; // KK (spread, tuple)
+  std::vector<ValueType> lsLoads;     // loads of lsMakespan
+};
+
+Workspace &workspace() {
+  thread_local Workspace ws;
+  return ws;
+}
+
+// Item accessors for the LS kernels. The k-th value visited is values[k];
+// order(k) is the input item it belongs to.
+struct InputOrder {
+  std::size_t operator()(std::size_t k) const { return k; }
+};
+
+struct PermutedOrder {
+  const ItemIndex *order;
+  std::size_t operator()(std::size_t k) const { return order[k]; }
+};
+
+// Sends every group write to the same slot, for callers that only need the
+// loads.
+struct DiscardOrder {
+  std::size_t operator()(std::size_t) const { return 0; }
+};
+
+// Largest n served by the fixed-size LS kernels.
+constexpr std::size_t SMALL_N = 16;
+
+// Fixed-n kernel: loads live in a stack array and the least-loaded group is
+// found with a branchless min/argmin scan that the compiler fully unrolls.
+template <std::size_t N, typename Order>
+void lsFixed(const ValueType *values, std::size_t m, Order order,
+             ValueType *loads, GroupIndex *groupOf) {
+  std::array<ValueType, N> sums = {};
+
+  for (std::size_t k = 0; k < m; k++) {
+    std::size_t best = 0;
+    ValueType bestSum = sums[0];
+    for (std::size_t g = 1; g < N; g++) {
+      bool less = sums[g] < bestSum;
+      bestSum = less ? sums[g] : bestSum;
+      best = less ? g : best;
+    }
+    sums[best] = bestSum + values[k];
+    groupOf[order(k)] = GroupIndex(best);
+  }
+
+  std::copy(sums.begin(), sums.end(), loads);
+}
+
+template <typename Order>
+using LsKernel = void (*)(const ValueType *, std::size_t, Order, ValueType *,
+                          GroupIndex *);
+
+template <typename Order, std::size_t... N>
+constexpr std::array<LsKernel<Order>, sizeof...(N)>
+makeLsKernels(std::index_sequence<N...>) {
+  return {{&lsFixed<N + 1, Order>...}};
+}
+
+/**
+ * @brief Array-backed loser tree over the loads of n groups.
+ *
+ * Node 0 holds the least-loaded group; every other node holds the loser of
+ * the match played there, with its load stored alongside. Increasing the
+ * winner's load replays only its leaf-to-root path, in place.
+ */
+class LoserTree {
+public:
+  void reset(std::size_t n) {
+    leaves_ = 1;
+    while (leaves_ < n) {
+      leaves_ *= 2;
+    }
+
+    // Winners of every subtree, built bottom-up (left wins ties)
+    winKey_.resize(2 * leaves_);
+    winSlot_.resize(2 * leaves_);
+    const ValueType unused = std::numeric_limits<ValueType>::max();
+    for (std::size_t j = 0; j < leaves_; j++) {
+      winKey_[leaves_ + j] = j < n ? 0 : unused;
+      winSlot_[leaves_ + j] = GroupIndex(j);
+    }
+
+    key_.resize(leaves_);
+    slot_.resize(leaves_);
+    for (std::size_t p = leaves_ - 1; p >= 1; p--) {
+      bool right = winKey_[2 * p + 1] < winKey_[2 * p];
+      std::size_t winner = right ? 2 * p + 1 : 2 * p;
+      std::size_t loser = right ? 2 * p : 2 * p + 1;
+      key_[p] = winKey_[loser];
+      slot_[p] = winSlot_[loser];
+      winKey_[p] = winKey_[winner];
+      winSlot_[p] = winSlot_[winner];
+    }
+    key_[0] = winKey_[1];
+    slot_[0] = winSlot_[1];
+  }
+
+  GroupIndex winner() const { return slot_[0]; }
+
+  // Adds x to the winner's load and replays its path to the root. Matches
+  // compare (load, group), so ties go to the first group as in reset().
+  void addToWinner(ValueType x) {
+    GroupIndex slot = slot_[0];
+    ValueType key = key_[0] + x;
+    for (std::size_t p = (leaves_ + slot) / 2; p >= 1; p /= 2) {
+      bool swap = key_[p] < key || (key_[p] == key && slot_[p] < slot);
+      ValueType otherKey = key_[p];
+      GroupIndex otherSlot = slot_[p];
+      key_[p] = swap ? key : otherKey;
+      slot_[p] = swap ? slot : otherSlot;
+      key = swap ? otherKey : key;
+      slot = swap ? otherSlot : slot;
+    }
+    key_[0] = key;
+    slot_[0] = slot;
+  }
+
+private:
+  std::size_t leaves_ = 0;
+  std::vector<ValueType> key_;
+  std::vector<GroupIndex> slot_;
+  std::vector<ValueType> winKey_;
+  std::vector<GroupIndex> winSlot_;
+};
+
+// Runtime-n kernel for larger n, driven by the loser tree.
+template <typename Order>
+void lsTree(const ValueType *values, std::size_t m, std::size_t n,
+            Order order, ValueType *loads, GroupIndex *groupOf) {
+  thread_local LoserTree tree;
+  tree.reset(n);
+  std::fill(loads, loads + n, ValueType{0});
+
+  for (std::size_t k = 0; k < m; k++) {
+    GroupIndex g = tree.winner();
+    groupOf[order(k)] = g;
+    loads[g] += values[k];
+    tree.addToWinner(values[k]);
+  }
+}
+
+// Runs LS over the m values in sequence, writing the load of every group and
+// the group of the input item behind every value.
+template <typename Order>
+void lsAssign(const ValueType *values, std::size_t m, std::size_t n,
+              Order order, ValueType *loads, GroupIndex *groupOf) {
+  static constexpr auto kernels =
+      makeLsKernels<Order>(std::make_index_sequence<SMALL_N>{});
+
+  if (n <= SMALL_N) {
+    kernels[n - 1](values, m, order, loads, groupOf);
+  } else {
+    lsTree(values, m, n, order, loads, groupOf);
+  }
+}
+
+void checkGroupCount(std::size_t n) {
+  if (n == 0) {
+    throw std::invalid_argument("n must be a positive integer");
+  }
+}
+
+// Sizes out for m items and n groups without shrinking its capacity.
+void prepare(Assignment &out, std::size_t m, std::size_t n) {
+  out.groupOf.resize(m);
+  out.loads.assign(n, 0);
+  out.makespan = 0;
+}
+
+void finish(Assignment &out) {
+  out.makespan = out.loads.empty()
+                     ? 0
+                     : *std::max_element(out.loads.begin(), out.loads.end());
+}
+
+// Below this many items a comparison sort beats the radix histograms.
+constexpr std::size_t RADIX_MIN_ITEMS = 256;
+
+// Largest radix digit, in bits (2048 buckets per pass).
+constexpr unsigned RADIX_MAX_DIGIT_BITS = 11;
+
+// Fills order with the item indices in decreasing order of value (ties keep
+// input order) and sorted with the matching values. Large inputs use a stable
+// LSD radix sort whose passes cover only the bit width B of the largest value:
+// B <= 11 takes a single counting pass, B = 32 takes three.
+void descendingOrder(const std::vector<ValueType> &arr,
+                     std::vector<ItemIndex> &order,
+                     std::vector<ValueType> &sorted) {
+  const std::size_t m = arr.size();
+  order.resize(m);
+  sorted.resize(m);
+
+  ValueType bitsOr = 0;
+  for (ValueType x : arr) {
+    bitsOr |= x;
+  }
+  unsigned bits = 0;
+  while (bits < 64 && (bitsOr >> bits) != 0) {
+    bits++;
+  }
+
+  if (m < RADIX_MIN_ITEMS || bits == 0) {
+    std::iota(order.begin(), order.end(), ItemIndex{0});
+    std::stable_sort(
+        order.begin(), order.end(),
+        [&arr](ItemIndex a, ItemIndex b) { return arr[a] > arr[b]; });
+    for (std::size_t k = 0; k < m; k++) {
+      sorted[k] = arr[order[k]];
+    }
+    return;
+  }
+
+  const unsigned passes =
+      (bits + RADIX_MAX_DIGIT_BITS - 1) / RADIX_MAX_DIGIT_BITS;
+  const unsigned digitBits = (bits + passes - 1) / passes;
+  const std::size_t buckets = std::size_t(1) << digitBits;
+  const ValueType mask = buckets - 1;
+
+  // Histograms of every pass in a single read of the input. Digits are
+  // complemented so that ascending bucket order yields decreasing values.
+  thread_local std::vector<std::size_t> counts;
+  counts.assign(passes * buckets, 0);
+  for (ValueType x : arr) {
+    for (unsigned p = 0; p < passes; p++) {
+      counts[p * buckets + (mask - ((x >> (p * digitBits)) & mask))]++;
+    }
+  }
+
+  thread_local std::vector<ValueType> keysTmp;
+  thread_local std::vector<ItemIndex> orderTmp;
+  keysTmp.resize(m);
+  orderTmp.resize(m);
+
+  // Ping-pong between (sorted, order) and the temporaries; the first pass
+  // reads straight from the caller's array.
+  ValueType *srcKeys = nullptr;
+  ItemIndex *srcOrder = nullptr;
+  ValueType *dstKeys = passes % 2 == 1 ? sorted.data() : keysTmp.data();
+  ItemIndex *dstOrder = passes % 2 == 1 ? order.data() : orderTmp.data();
+
+  for (unsigned p = 0; p < passes; p++) {
+    std::size_t *count = &counts[p * buckets];
+    std::size_t offset = 0;
+    for (std::size_t b = 0; b < buckets; b++) {
+      std::size_t c = count[b];
+      count[b] = offset;
+      offset += c;
+    }
+
+    const unsigned shift = p * digitBits;
+    for (std::size_t k = 0; k < m; k++) {
+      ValueType x = srcKeys ? srcKeys[k] : arr[k];
+      ItemIndex i = srcOrder ? srcOrder[k] : ItemIndex(k);
+      std::size_t pos = count[mask - ((x >> shift) & mask)]++;
+      dstKeys[pos] = x;
+      dstOrder[pos] = i;
+    }
+
+    srcKeys = dstKeys;
+    srcOrder = dstOrder;
+    dstKeys = dstKeys == sorted.data() ? keysTmp.data() : sorted.data();
+    dstOrder = dstOrder == order.data() ? orderTmp.data() : order.data();
+  }
+}
+
+/**
+ * @brief First Fit Decreasing over values already in decreasing order.
+ *
+ * Bin slots are the leaves of an array-backed max segment tree over their
+ * remaining capacity; unopened bins are simply slots at full capacity. The
+ * leftmost bin that fits an item is found by one root-to-leaf descent and
+ * updated in place.
+ *
+ * @param sorted The values to pack, in decreasing order.
+ * @param m The number of values.
+ * @param capacity The capacity of every bin.
+ * @param maxBins The number of bins available.
+ * @param binOf Receives the bin of every value, unless it is null.
+ * @return The number of bins used, or maxBins + 1 as soon as the values do
+ * not fit into maxBins bins.
+ */
+std::size_t ffdAssign(const ValueType *sorted, std::size_t m,
+                      ValueType capacity, std::size_t maxBins,
+                      GroupIndex *binOf) {
+  std::size_t leaves = 1;
+  while (leaves < maxBins) {
+    leaves *= 2;
+  }
+
+  // tree[1] is the root; slots past maxBins never fit anything
+  thread_local std::vector<ValueType> tree;
+  tree.assign(2 * leaves, 0);
+  std::fill(tree.begin() + leaves, tree.begin() + leaves + maxBins, capacity);
+  for (std::size_t p = leaves - 1; p >= 1; p--) {
+    tree[p] = std::max(tree[2 * p], tree[2 * p + 1]);
+  }
+
+  std::size_t used = 0;
+  for (std::size_t k = 0; k < m; k++) {
+    ValueType x = sorted[k];
+
+    std::size_t p = 1;
+    if (tree[1] >= x) {
+      // Leftmost bin with remaining capacity >= x
+      while (p < leaves) {
+        p = tree[2 * p] >= x ? 2 * p : 2 * p + 1;
+      }
+      tree[p] -= x;
+    } else if (used < maxBins) {
+      // Larger than the capacity: it gets the next empty bin on its own
+      p = leaves + used;
+      tree[p] = 0;
+    } else {
+      return maxBins + 1;
+    }
+
+    std::size_t slot = p - leaves;
+    used = std::max(used, slot + 1);
+    if (binOf) {
+      binOf[k] = GroupIndex(slot);
+    }
+
+    for (p /= 2; p >= 1; p /= 2) {
+      tree[p] = std::max(tree[2 * p], tree[2 * p + 1]);
+    }
+  }
+
+  return used;
+}
+
+// Marks an empty slot of a Karmarkar-Karp tuple.
+constexpr uint32_t KK_EMPTY = std::numeric_limits<uint32_t>::max();
+
+/**
+ * @brief Multi-way Karmarkar-Karp differencing over values in decreasing
+ * order.
+ *
+ * Every partial partition is an n-tuple of loads in decreasing order, shifted
+ * so that the smallest is 0; its spread is the largest load. The two tuples
+ * with the largest spreads are merged until one is left, pairing the largest
+ * load of one with the smallest of the other. Single items are the tuples
+ * (v, 0, ..., 0) and are read straight from sorted, so only merged tuples are
+ * stored. Every slot carries a linked list of its items.
+ *
+ * @param sorted The values in decreasing order.
+ * @param m The number of values.
+ * @param n The number of groups.
+ * @param groupOf Receives the group of each sorted value.
+ */
+void kkAssign(const ValueType *sorted, std::size_t m, std::size_t n,
+              GroupIndex *groupOf) {
+  if (m == 0) {
+    return;
+  }
+
+  Workspace &ws = workspace();
+  std::vector<ValueType> &loads = ws.kkLoads;
+  std::vector<uint32_t> &sets = ws.kkSets;
+  std::vector<uint32_t> &next = ws.kkNext;
+  std::vector<uint32_t> &tail = ws.kkTail;
+  std::vector<uint32_t> &freeSlots = ws.kkFree;
+  auto &heap = ws.kkHeap;
+
+  loads.clear();
+  sets.clear();
+  freeSlots.clear();
+  heap.clear();
+  next.assign(m, KK_EMPTY);
+  tail.resize(m);
+  std::iota(tail.begin(), tail.end(), uint32_t{0});
+
+  auto join = [&](uint32_t a, uint32_t b) {
+    if (a == KK_EMPTY) {
+      return b;
+    }
+    if (b != KK_EMPTY) {
+      next[tail[a]] = b;
+      tail[a] = tail[b];
     }
+    return a;
   };
 
-  std::vector<std::vector<ValueType>> groups;
-  std::multiset<Bin> bins;
+  // Copies the tuple with the largest spread into (load, set) and drops it
+  std::size_t single = 0;
+  auto take = [&](std::pair<ValueType, uint32_t> *tuple) {
+    if (single < m && (heap.empty() || sorted[single] >= heap.front().first)) {
+      tuple[0] = {sorted[single], uint32_t(single)};
+      for (std::size_t k = 1; k < n; k++) {
+        tuple[k] = {0, KK_EMPTY};
+      }
+      single++;
+      return;
+    }
+
+    std::pop_heap(heap.begin(), heap.end());
+    uint32_t slot = heap.back().second;
+    heap.pop_back();
+    for (std::size_t k = 0; k < n; k++) {
+      tuple[k] = {loads[slot * n + k], sets[slot * n + k]};
+    }
+    freeSlots.push_back(slot);
+  };
 
-  for (auto &x : arr) {
-    // First bin with remaining capacity >= x
-    auto it = bins.lower_bound(Bin{ValueType(x), std::size_t(0)});
+  std::vector<std::pair<ValueType, uint32_t>> a(n), b(n);
+  while ((m - single) + heap.size() > 1) {
+    take(a.data());
+    take(b.data());
 
-    // No bin with remaining capacity >= x
-    if (it == bins.end()) {
-      groups.push_back({x});
-      bins.insert(Bin{capacity - x, std::size_t(groups.size() - 1)});
+    // Largest of a with smallest of b, then back in decreasing order
+    for (std::size_t k = 0; k < n; k++) {
+      a[k].first += b[n - 1 - k].first;
+      a[k].second = join(a[k].second, b[n - 1 - k].second);
+    }
+    std::sort(a.begin(), a.end(),
+              [](const std::pair<ValueType, uint32_t> &x,
+                 const std::pair<ValueType, uint32_t> &y) {
+                return x.first > y.first;
+              });
+
+    uint32_t slot;
+    if (freeSlots.empty()) {
+      slot = uint32_t(loads.size() / n);
+      loads.resize(loads.size() + n);
+      sets.resize(sets.size() + n);
     } else {
-      // Bin with remaining capacity >= x
-      groups[it->idx].push_back(x);
-      Bin newBin{it->remaining - x, it->idx};
-      bins.erase(it);
-      bins.insert(newBin);
+      slot = freeSlots.back();
+      freeSlots.pop_back();
+    }
+
+    const ValueType smallest = a[n - 1].first;
+    for (std::size_t k = 0; k < n; k++) {
+      loads[slot * n + k] = a[k].first - smallest;
+      sets[slot * n + k] = a[k].second;
     }
+    heap.push_back({a[0].first - smallest, slot});
+    std::push_heap(heap.begin(), heap.end());
   }
 
+  // A single item is the whole partition when m == 1
+  if (heap.empty()) {
+    groupOf[0] = 0;
+    return;
+  }
+
+  uint32_t slot = heap.front().second;
+  for (std::size_t k = 0; k < n; k++) {
+    for (uint32_t item = sets[slot * n + k]; item != KK_EMPTY;
+         item = next[item]) {
+      groupOf[item] = GroupIndex(k);
+    }
+  }
+}
+
+// Search nodes visited between two polls of the solve control.
+constexpr std::size_t CGA_POLL_INTERVAL = 4096;
+
+// State shared by every branch of one CGA search.
+struct CgaSearch {
+  const ValueType *values; // decreasing order
+  std::size_t m;
+  ValueType lowerbound;
+  std::atomic<ValueType> makespan; // incumbent, read without the lock
+  std::mutex mutex;                // guards best and makespan updates
+  std::vector<GroupIndex> *best;   // group of each sorted item
+  const SolveControl &control;
+  SolveControl::Clock::time_point start;
+  std::atomic<bool> stopped{false}; // the control asked to stop
+  SolveStats *stats;                // of the caller's scope, may be null
+
+  CgaSearch(const ValueType *values, std::size_t m, ValueType lowerbound,
+            ValueType makespan, std::vector<GroupIndex> *best,
+            const SolveControl &control, SolveControl::Clock::time_point start)
+      : values(values), m(m), lowerbound(lowerbound), makespan(makespan),
+        best(best), control(control), start(start), stats(currentStats()) {}
+
+  ValueType incumbent() const {
+    return makespan.load(std::memory_order_relaxed);
+  }
+
+  // No branch can beat a solution at the lower bound
+  bool finished() const {
+    return incumbent() <= lowerbound ||
+           stopped.load(std::memory_order_relaxed);
+  }
+
+  // Checks the deadline and the cancel token; true once the search must stop
+  bool poll() {
+    if (control.stopRequested()) {
+      stopped.store(true, std::memory_order_relaxed);
+    }
+    return stopped.load(std::memory_order_relaxed);
+  }
+
+  void offer(const GroupIndex *assignment, ValueType candidate) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (candidate < incumbent()) {
+      makespan.store(candidate, std::memory_order_relaxed);
+      std::copy(assignment, assignment + m, best->begin());
+      control.report(start, candidate, lowerbound);
+      PARTITION_STAT(if (stats) stats->improved());
+    }
+  }
+};
+
+// Partial CGA solution. Loads are kept in increasing order, so the makespan
+// is the last one and groups with equal loads are adjacent; groupAt[k] is the
+// group whose load is loads[k].
+struct CgaNode {
+  ValueType *loads;
+  GroupIndex *groupAt;
+  GroupIndex *assignment; // group of each placed item (sorted order)
+  std::size_t n;
+  std::size_t i; // next item to place
+};
+
+// Adds value to slot p and moves it right to restore the order. Returns the
+// slot it ends in.
+std::size_t cgaPlace(CgaNode &node, std::size_t p, ValueType value) {
+  ValueType load = node.loads[p] + value;
+  GroupIndex group = node.groupAt[p];
+  std::size_t q = p;
+  for (; q + 1 < node.n && node.loads[q + 1] < load; q++) {
+    node.loads[q] = node.loads[q + 1];
+    node.groupAt[q] = node.groupAt[q + 1];
+  }
+  node.loads[q] = load;
+  node.groupAt[q] = group;
+  return q;
+}
+
+// Exact inverse of cgaPlace(node, p, value) that returned q.
+void cgaUnplace(CgaNode &node, std::size_t p, std::size_t q,
+                ValueType value) {
+  ValueType load = node.loads[q] - value;
+  GroupIndex group = node.groupAt[q];
+  for (; q > p; q--) {
+    node.loads[q] = node.loads[q - 1];
+    node.groupAt[q] = node.groupAt[q - 1];
+  }
+  node.loads[p] = load;
+  node.groupAt[p] = group;
+}
+
+// First slot from p on that is worth trying for value: the first of a run of
+// equal loads, and only while the grown load stays below bound. Returns n when
+// there is none, since loads only grow to the right. Skipped slots are counted
+// into counts.
+std::size_t cgaNextSlot(const CgaNode &node, std::size_t p, ValueType value,
+                        ValueType bound,
+                        [[maybe_unused]] SolveStats &counts) {
+  for (; p < node.n; p++) {
+    if (node.loads[p] + value >= bound) {
+      PARTITION_STAT(counts.prunedUpper++);
+      return node.n;
+    }
+    if (p == 0 || node.loads[p] != node.loads[p - 1]) {
+      return p;
+    }
+    PARTITION_STAT(counts.prunedSymmetry++);
+  }
+  return node.n;
+}
+
+/**
+ * @brief A backtracking algorithm to find the optimal partition of the array
+ * into n groups using a Complete Greedy Algorithm (CGA) approach.
+ *
+ * Depth-first over an explicit stack indexed by item. Every node tries the
+ * groups in increasing load order, skipping loads equal to the previous one.
+ * Nothing is allocated once the workspace grew to m items.
+ *
+ * @param search The values, bounds and incumbent shared by all branches.
+ * @param node The partial solution to complete. It is restored on return,
+ * unless the search reached the lower bound or was stopped.
+ */
+void CGABacktracking(CgaSearch &search, CgaNode &node) {
+  const std::size_t m = search.m;
+  const std::size_t root = node.i;
+  const ValueType *values = search.values;
+
+  Workspace &ws = workspace();
+  ws.cgaNext.resize(m + 1);
+  ws.cgaFrom.resize(m);
+  ws.cgaTo.resize(m);
+  uint32_t *next = ws.cgaNext.data();
+  uint32_t *from = ws.cgaFrom.data();
+  uint32_t *to = ws.cgaTo.data();
+
+  SolveStats counts;
+  std::size_t i = root;
+  next[i] = 0;
+  for (std::size_t steps = 1;; steps++) {
+    if (steps % CGA_POLL_INTERVAL == 0 && search.poll()) {
+      break;
+    }
+
+    ValueType bound = search.incumbent();
+    ValueType makespan = node.loads[node.n - 1];
+
+    if (i == m) {
+      // Base case: every slot stayed below the incumbent on the way down
+      if (makespan < bound) {
+        search.offer(node.assignment, makespan);
+      }
+    } else if (makespan < bound) {
+      std::size_t p = cgaNextSlot(node, next[i], values[i], bound, counts);
+      if (p < node.n) {
+        // Descend
+        PARTITION_STAT(counts.nodes++);
+        std::size_t q = cgaPlace(node, p, values[i]);
+        node.assignment[i] = node.groupAt[q];
+        next[i] = uint32_t(p + 1);
+        from[i] = uint32_t(p);
+        to[i] = uint32_t(q);
+        next[++i] = 0;
+        continue;
+      }
+    } else {
+      PARTITION_STAT(counts.prunedUpper++);
+    }
+
+    // Backtrack
+    if (i == root || search.finished()) {
+      // The rest of the tree is cut once the incumbent meets the lower bound
+      PARTITION_STAT(if (i != root && search.incumbent() <= search.lowerbound)
+                         counts.prunedLower++);
+      break;
+    }
+    i--;
+    cgaUnplace(node, from[i], to[i], values[i]);
+  }
+  node.i = root;
+  PARTITION_STAT(if (search.stats) search.stats->add(counts));
+}
+
+/**
+ * @brief Expands the CGA tree down to splitDepth, spawning one task per
+ * surviving node, and searches every node at that depth sequentially.
+ *
+ * Children are queued worst first, so the worker that owns them resumes with
+ * the greedy choice while thieves take the other subtrees.
+ *
+ * @param search The values, bounds and incumbent shared by all branches.
+ * @param group The task group of the search.
+ * @param splitDepth The depth at which nodes stop spawning tasks.
+ * @param loads The loads of the partial solution, in increasing order.
+ * @param groupAt The group of each load.
+ * @param assignment The group of each placed item.
+ * @param i The next item to place.
+ */
+void CGABranch(CgaSearch &search, TaskGroup &group, std::size_t splitDepth,
+               std::vector<ValueType> loads, std::vector<GroupIndex> groupAt,
+               std::vector<GroupIndex> assignment, std::size_t i) {
+  if (search.finished()) {
+    return;
+  }
+
+  CgaNode node{loads.data(), groupAt.data(), assignment.data(), loads.size(),
+               i};
+  if (i >= splitDepth || i == search.m) {
+    CGABacktracking(search, node);
+    return;
+  }
+
+  const ValueType value = search.values[i];
+  SolveStats counts;
+  std::vector<std::size_t> slots;
+  for (std::size_t p = cgaNextSlot(node, 0, value, search.incumbent(), counts);
+       p < node.n;
+       p = cgaNextSlot(node, p + 1, value, search.incumbent(), counts)) {
+    slots.push_back(p);
+  }
+  PARTITION_STAT(counts.nodes += slots.size());
+  PARTITION_STAT(if (search.stats) search.stats->add(counts));
+
+  for (auto it = slots.rbegin(); it != slots.rend(); ++it) {
+    std::size_t p = *it;
+    std::vector<ValueType> childLoads = loads;
+    std::vector<GroupIndex> childGroupAt = groupAt;
+    CgaNode child{childLoads.data(), childGroupAt.data(), assignment.data(),
+                  node.n, i};
+    std::size_t q = cgaPlace(child, p, value);
+    assignment[i] = childGroupAt[q];
+
+    group.run([&search, &group, splitDepth, childLoads, childGroupAt,
+               assignment, i] {
+      CGABranch(search, group, splitDepth, childLoads, childGroupAt,
+                assignment, i + 1);
+    });
+  }
+}
+
+// Split depth with enough subtrees to keep the pool busy. Item i can open at
+// most min(n, i + 1) branches, since all groups start empty.
+std::size_t cgaSplitDepth(std::size_t m, std::size_t n, std::size_t threads) {
+  const std::size_t target = 16 * threads;
+  std::size_t depth = 0;
+  for (std::size_t nodes = 1; nodes < target && depth < m; depth++) {
+    nodes *= std::min(n, depth + 1);
+  }
+  return depth;
+}
+
+#if PARTITION_STATS
+thread_local SolveStats *scopeStats = nullptr;
+#endif
+
+// Serializes the updates of every SolveStats; they happen once per search or
+// worker, not per node.
+std::mutex statsMutex;
+} // namespace
+
+#if PARTITION_STATS
+SolveStats *currentStats() { return scopeStats; }
+#endif
+
+void SolveStats::add(const SolveStats &delta) {
+  std::lock_guard<std::mutex> lock(statsMutex);
+  nodes += delta.nodes;
+  prunedUpper += delta.prunedUpper;
+  prunedLower += delta.prunedLower;
+  prunedSymmetry += delta.prunedSymmetry;
+  probes += delta.probes;
+  probeBins += delta.probeBins;
+  generations += delta.generations;
+  evaluations += delta.evaluations;
+  cacheHits += delta.cacheHits;
+  proposed += delta.proposed;
+  accepted += delta.accepted;
+  if (delta.finalTemperature != 0) {
+    finalTemperature = delta.finalTemperature;
+  }
+}
+
+void SolveStats::improved() {
+  std::lock_guard<std::mutex> lock(statsMutex);
+  timeToBest = Clock::now() - start;
+  hasBest = true;
+}
+
+StatsScope::StatsScope(SolveStats &stats) : previous_(nullptr) {
+#if PARTITION_STATS
+  previous_ = scopeStats;
+  scopeStats = &stats;
+  stats.start = SolveStats::Clock::now();
+  stats.hasBest = false;
+#else
+  (void)stats;
+#endif
+}
+
+StatsScope::~StatsScope() {
+#if PARTITION_STATS
+  // Solvers that never reported an incumbent built a single solution
+  if (!scopeStats->hasBest) {
+    scopeStats->timeToBest = SolveStats::Clock::now() - scopeStats->start;
+  }
+  scopeStats = previous_;
+#endif
+}
+
+void LS(const std::vector<ValueType> &arr, std::size_t n, Assignment &out) {
+  checkGroupCount(n);
+
+  prepare(out, arr.size(), n);
+  lsAssign(arr.data(), arr.size(), n, InputOrder{}, out.loads.data(),
+           out.groupOf.data());
+  finish(out);
+}
+
+ValueType lsMakespan(const ValueType *values, std::size_t m, std::size_t n) {
+  checkGroupCount(n);
+
+  Workspace &ws = workspace();
+  ws.lsLoads.resize(n);
+  GroupIndex discarded;
+  lsAssign(values, m, n, DiscardOrder{}, ws.lsLoads.data(), &discarded);
+  return *std::max_element(ws.lsLoads.begin(), ws.lsLoads.end());
+}
+
+void lsOrdered(const ValueType *values, const ItemIndex *order, std::size_t m,
+               std::size_t n, Assignment &out) {
+  checkGroupCount(n);
+
+  prepare(out, m, n);
+  lsAssign(values, m, n, PermutedOrder{order}, out.loads.data(),
+           out.groupOf.data());
+  finish(out);
+}
+
+void LPT(const std::vector<ValueType> &arr, std::size_t n, Assignment &out) {
+  checkGroupCount(n);
+
+  Workspace &ws = workspace();
+  descendingOrder(arr, ws.order, ws.sorted);
+
+  prepare(out, arr.size(), n);
+  lsAssign(ws.sorted.data(), arr.size(), n, PermutedOrder{ws.order.data()},
+           out.loads.data(), out.groupOf.data());
+  finish(out);
+}
+
+void KK(const std::vector<ValueType> &arr, std::size_t n, Assignment &out) {
+  checkGroupCount(n);
+
+  Workspace &ws = workspace();
+  descendingOrder(arr, ws.order, ws.sorted);
+
+  prepare(out, arr.size(), n);
+  ws.bestBins.resize(arr.size());
+  kkAssign(ws.sorted.data(), arr.size(), n, ws.bestBins.data());
+
+  for (std::size_t i = 0; i < arr.size(); i++) {
+    out.groupOf[ws.order[i]] = ws.bestBins[i];
+    out.loads[ws.bestBins[i]] += ws.sorted[i];
+  }
+  finish(out);
+}
+
+void MULTIFIT(const std::vector<ValueType> &arr, std::size_t n,
+              Assignment &out, std::size_t k) {
+  MULTIFIT(arr, n, out, MultifitOptions{k, 1});
+}
+
+void MULTIFIT(const std::vector<ValueType> &arr, std::size_t n,
+              Assignment &out, const MultifitOptions &options) {
+  checkGroupCount(n);
+  if (n == 1 || arr.empty()) {
+    LS(arr, n, out);
+    return;
+  }
+
+  Workspace &ws = workspace();
+  descendingOrder(arr, ws.order, ws.sorted);
+  const std::vector<ValueType> &sorted = ws.sorted;
+
+  ValueType sum = std::accumulate(sorted.begin(), sorted.end(), ValueType{0});
+  ValueType max = sorted.front();
+
+  ValueType lowerBound = std::max<ValueType>(max, sum / n);
+  ValueType upperBound = std::max<ValueType>(max, 2 * sum / n);
+
+  // Only bin counts are needed while searching: probes stop as soon as the
+  // values need more than n bins
+  SolveStats counts;
+  std::vector<std::size_t> bins;
+  auto probe = [&](std::size_t j, ValueType capacity) {
+    bins[j] = ffdAssign(sorted.data(), sorted.size(), capacity, n, nullptr);
+    return bins[j] <= n;
+  };
+
+  // Keep lowerBound as a capacity known to fail and upperBound as one known to
+  // fit; anything below max(max, sum / n) fails
+  if (lowerBound > 0) {
+    lowerBound--;
+  }
+
+  const std::size_t probes = std::max<std::size_t>(1, options.threads);
+  std::vector<ValueType> candidates;
+  std::vector<char> fits;
+
+  for (std::size_t round = 0;
+       (options.iterations == 0 || round < options.iterations) &&
+       upperBound - lowerBound > 1;
+       round++) {
+    // Evenly spaced capacities strictly inside (lowerBound, upperBound)
+    ValueType width = upperBound - lowerBound;
+    candidates.clear();
+    for (std::size_t j = 1; j <= probes; j++) {
+      ValueType capacity =
+          lowerBound + ValueType((static_cast<unsigned __int128>(width) * j) /
+                                 (probes + 1));
+      if (capacity > lowerBound && capacity < upperBound &&
+          (candidates.empty() || capacity > candidates.back())) {
+        candidates.push_back(capacity);
+      }
+    }
+
+    fits.assign(candidates.size(), 0);
+    bins.assign(candidates.size(), 0);
+    if (candidates.size() == 1) {
+      fits[0] = probe(0, candidates[0]);
+    } else {
+      ThreadPool::shared().parallelFor(candidates.size(), [&](std::size_t j) {
+        fits[j] = probe(j, candidates[j]);
+      });
+    }
+    PARTITION_STAT(counts.probes += candidates.size());
+    PARTITION_STAT(for (std::size_t b : bins) counts.probeBins += b);
+
+    // Narrow to the gap below the smallest feasible candidate
+    for (std::size_t j = 0; j < candidates.size(); j++) {
+      if (fits[j]) {
+        upperBound = candidates[j];
+        break;
+      }
+      lowerBound = candidates[j];
+    }
+  }
+
+  PARTITION_STAT(if (SolveStats *stats = currentStats()) stats->add(counts));
+
+  // Pack for the smallest feasible capacity found
+  ws.bestBins.resize(sorted.size());
+  ffdAssign(sorted.data(), sorted.size(), upperBound, n, ws.bestBins.data());
+
+  prepare(out, arr.size(), n);
+  for (std::size_t i = 0; i < sorted.size(); i++) {
+    out.groupOf[ws.order[i]] = ws.bestBins[i];
+    out.loads[ws.bestBins[i]] += sorted[i];
+  }
+  finish(out);
+}
+
+void CGA(const std::vector<ValueType> &arr, std::size_t n, Assignment &out) {
+  CGA(arr, n, out, CgaOptions{});
+}
+
+void CGA(const std::vector<ValueType> &arr, std::size_t n, Assignment &out,
+         const CgaOptions &options) {
+  CGA(arr, n, out, options, SolveControl{});
+}
+
+SolveStatus CGA(const std::vector<ValueType> &arr, std::size_t n,
+                Assignment &out, const CgaOptions &options,
+                const SolveControl &control) {
+  // Check if n is valid
+  checkGroupCount(n);
+  const auto start = SolveControl::Clock::now();
+
+  // Get one solution (LPT over the values in decreasing order)
+  Workspace &ws = workspace();
+  descendingOrder(arr, ws.order, ws.sorted);
+  const std::vector<ValueType> &sorted = ws.sorted;
+
+  prepare(out, arr.size(), n);
+  ws.bestBins.resize(sorted.size());
+  lsAssign(sorted.data(), sorted.size(), n, InputOrder{}, out.loads.data(),
+           ws.bestBins.data());
+
+  // Get makespan
+  ValueType makespan = *std::max_element(out.loads.begin(), out.loads.end());
+
+  // Get makespan lowerbound
+  ValueType total = std::accumulate(sorted.begin(), sorted.end(), ValueType{0});
+  ValueType lowerbound = (total + n - 1) / n;
+  if (!sorted.empty()) {
+    lowerbound = std::max(lowerbound, sorted.front());
+  }
+  control.report(start, makespan, lowerbound);
+#if PARTITION_STATS
+  if (SolveStats *stats = currentStats()) {
+    stats->improved();
+    // The greedy solution already meets the bound: the whole tree is cut
+    SolveStats cut;
+    cut.prunedLower = lowerbound >= makespan ? 1 : 0;
+    stats->add(cut);
+  }
+#endif
+
+  // Get best solution
+  SolveStatus status;
+  if (lowerbound < makespan) {
+    // With a single worker the split only interleaves subtrees on one core
+    // and delays the greedy incumbent, so search sequentially instead
+    ThreadPool &pool = ThreadPool::shared();
+    const bool parallel = options.parallel && pool.size() > 1;
+
+    // A parallel search reads its values and writes its bins from other
+    // threads for as long as it runs, so it gets its own copies instead of
+    // this thread's workspace
+    std::vector<ValueType> values;
+    std::vector<GroupIndex> bins;
+    if (parallel) {
+      values = sorted;
+      bins = ws.bestBins;
+    }
+    CgaSearch search(parallel ? values.data() : sorted.data(), sorted.size(),
+                     lowerbound, makespan, parallel ? &bins : &ws.bestBins,
+                     control, start);
+
+    if (parallel) {
+      std::size_t splitDepth =
+          options.splitDepth > 0
+              ? options.splitDepth
+              : cgaSplitDepth(sorted.size(), n, pool.size() + 1);
+
+      std::vector<GroupIndex> groupAt(n);
+      std::iota(groupAt.begin(), groupAt.end(), 0);
+
+      TaskGroup group(pool);
+      CGABranch(search, group, splitDepth, std::vector<ValueType>(n, 0),
+                std::move(groupAt), std::vector<GroupIndex>(sorted.size(), 0),
+                0);
+      group.wait();
+      std::copy(bins.begin(), bins.end(), ws.bestBins.begin());
+    } else {
+      ws.cgaLoads.assign(n, 0);
+      ws.cgaGroupAt.resize(n);
+      std::iota(ws.cgaGroupAt.begin(), ws.cgaGroupAt.end(), 0);
+      ws.current.resize(sorted.size());
+
+      CgaNode root{ws.cgaLoads.data(), ws.cgaGroupAt.data(),
+                   ws.current.data(), n, 0};
+      CGABacktracking(search, root);
+    }
+
+    status.interrupted = search.stopped && search.incumbent() > lowerbound;
+  }
+
+  std::fill(out.loads.begin(), out.loads.end(), 0);
+  for (std::size_t i = 0; i < sorted.size(); i++) {
+    out.groupOf[ws.order[i]] = ws.bestBins[i];
+    out.loads[ws.bestBins[i]] += sorted[i];
+  }
+  finish(out);
+
+  status.optimal = !status.interrupted;
+  status.lowerBound = status.optimal ? out.makespan : lowerbound;
+  return status;
+}
+
+Groups toGroups(const std::vector<ValueType> &arr,
+                const Assignment &assignment) {
+  const std::size_t n = assignment.loads.size();
+  std::vector<std::size_t> counts(n, 0);
+  for (GroupIndex g : assignment.groupOf) {
+    counts[g]++;
+  }
+
+  Groups groups(n);
+  for (std::size_t g = 0; g < n; g++) {
+    groups[g].reserve(counts[g]);
+  }
+  for (std::size_t i = 0; i < arr.size(); i++) {
+    groups[assignment.groupOf[i]].push_back(arr[i]);
+  }
   return groups;
 }
-} // namespace partition
\ No newline at end of file
+
+std::vector<std::vector<ValueType>> FFD(const std::vector<ValueType> &arr,
+                                        ValueType capacity) {
+  std::vector<GroupIndex> binOf(arr.size());
+  std::size_t binCount =
+      ffdAssign(arr.data(), arr.size(), capacity, arr.size(), binOf.data());
+
+  std::vector<std::vector<ValueType>> groups(binCount);
+  for (std::size_t i = 0; i < arr.size(); i++) {
+    groups[binOf[i]].push_back(arr[i]);
+  }
+  return groups;
+}
+
+Groups LS(const std::vector<ValueType> &arr, std::size_t n) {
+  Assignment assignment;
+  LS(arr, n, assignment);
+  return toGroups(arr, assignment);
+}
+
+Groups LPT(const std::vector<ValueType> &arr, std::size_t n) {
+  Assignment assignment;
+  LPT(arr, n, assignment);
+  return toGroups(arr, assignment);
+}
+
+Groups KK(const std::vector<ValueType> &arr, std::size_t n) {
+  Assignment assignment;
+  KK(arr, n, assignment);
+  return toGroups(arr, assignment);
+}
+
+Groups MULTIFIT(const std::vector<ValueType> &arr, std::size_t n,
+                std::size_t k) {
+  Assignment assignment;
+  MULTIFIT(arr, n, assignment, k);
+  return toGroups(arr, assignment);
+}
+
+Groups CGA(const std::vector<ValueType> &arr, std::size_t n) {
+  Assignment assignment;
+  CGA(arr, n, assignment);
+  return toGroups(arr, assignment);
+}
+} // namespace partition
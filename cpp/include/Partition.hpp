@@ -3,7 +3,11 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <chrono>
 #include <cstdint>
+#include <functional>
+#include <limits>
 #include <vector>
 
 namespace partition {
@@ -11,112 +15,947 @@ namespace partition {
 // Define ValueType as uint64_t;
 using ValueType = uint64_t;
 
+// Index of an item of the input array.
+using ItemIndex = uint32_t;
+
+// Index of a group (machine) of a partition.
+using GroupIndex = uint32_t;
+
+// Groups produced by the runtime-n solvers, one vector per group.
+using Groups = std::vector<std::vector<ValueType>>;
+
+/**
+ * @brief Index-based solution of a partition.
+ *
+ * Stores which group every input item went to and the load of every group.
+ * Solvers write into a caller-supplied Assignment and only grow its buffers,
+ * so reusing one object across calls does not allocate.
+ */
+struct Assignment {
+  std::vector<GroupIndex> groupOf; // item -> group, in input order
+  std::vector<ValueType> loads;    // group -> sum of its items
+  ValueType makespan = 0;          // largest group load
+};
+
+/**
+ * @brief Time limit, cancellation and progress reporting of an anytime solve.
+ *
+ * Solvers poll it between steps (a few thousand search nodes, one GA
+ * generation, one SA temperature), so they overrun the deadline by at most
+ * one step. On a stop they return the best solution found so far.
+ */
+struct SolveControl {
+  using Clock = std::chrono::steady_clock;
+
+  // Point past which the solver returns its incumbent; max() sets no limit.
+  Clock::time_point deadline = Clock::time_point::max();
+  // Stops the solver once set by another thread; may be null.
+  const std::atomic<bool> *cancel = nullptr;
+  // Control this one is nested in: stops the solver whenever it would.
+  // May be null.
+  const SolveControl *parent = nullptr;
+  // Called as progress(elapsed, incumbent, lower bound) whenever the solver
+  // finds a better solution. Calls are serialized. May be empty.
+  std::function<void(Clock::duration, ValueType, ValueType)> progress;
+
+  // Control whose deadline is budget from now.
+  static SolveControl within(Clock::duration budget) {
+    SolveControl control;
+    control.deadline = Clock::now() + budget;
+    return control;
+  }
+
+  // Whether the deadline passed or a cancellation was requested.
+  bool stopRequested() const {
+    if (cancel != nullptr && cancel->load(std::memory_order_relaxed)) {
+      return true;
+    }
+    if (parent != nullptr && parent->stopRequested()) {
+      return true;
+    }
+    return deadline != Clock::time_point::max() && Clock::now() >= deadline;
+  }
+
+  // Reports a better incumbent of a solve started at start.
+  void report(Clock::time_point start, ValueType incumbent,
+              ValueType lowerBound) const {
+    if (progress) {
+      progress(Clock::now() - start, incumbent, lowerBound);
+    }
+  }
+};
+
+/**
+ * @brief Outcome of an anytime solve.
+ */
+struct SolveStatus {
+  bool optimal = false;     // the makespan was proven optimal
+  bool interrupted = false; // stopped by the deadline or the cancel token
+  ValueType lowerBound = 0; // best lower bound known on the makespan
+};
+
+// Compiles the search counters of SolveStats in when 1. Set through the
+// PARTITION_STATS CMake option; must match between the library and its users.
+#ifndef PARTITION_STATS
+#define PARTITION_STATS 0
+#endif
+
+// Expands to statement only when the counters are compiled in.
+#if PARTITION_STATS
+#define PARTITION_STAT(statement) statement
+#else
+#define PARTITION_STAT(statement)
+#endif
+
+/**
+ * @brief Search and convergence counters of the solves run inside a
+ * StatsScope.
+ *
+ * Every solver fills in the counters that apply to it, including solvers it
+ * calls internally (RNP's MULTIFIT upper bound, SA's LPT start). Hot loops
+ * count into locals that are added once per search or worker. Built with
+ * PARTITION_STATS 0 the counting is compiled out and the fields stay zero.
+ */
+struct SolveStats {
+  using Clock = SolveControl::Clock;
+
+  // CGA (nodes also for RNP)
+  uint64_t nodes = 0;          // search nodes visited
+  uint64_t prunedUpper = 0;    // branches cut by the incumbent
+  uint64_t prunedLower = 0;    // searches ended by reaching the lower bound
+  uint64_t prunedSymmetry = 0; // groups skipped for repeating a load
+  // MULTIFIT
+  uint64_t probes = 0;    // FFD packings tried
+  uint64_t probeBins = 0; // bins used, summed over the probes
+  // Genetic algorithms
+  uint64_t generations = 0;
+  uint64_t evaluations = 0; // genomes scored
+  uint64_t cacheHits = 0;   // genomes whose score was already cached
+  // Simulated annealing
+  uint64_t proposed = 0;       // neighbours evaluated
+  uint64_t accepted = 0;       // neighbours moved to
+  double finalTemperature = 0; // of the chain whose solution was returned
+  // From the start of the scope to the last better incumbent; the whole
+  // solve for solvers that build a single solution.
+  Clock::duration timeToBest{};
+
+  // Adds the counters of delta, and its final temperature if it has one.
+  // Safe to call concurrently.
+  void add(const SolveStats &delta);
+
+  // Records that a better incumbent was just found. Safe to call
+  // concurrently.
+  void improved();
+
+  Clock::time_point start{}; // of the scope
+  bool hasBest = false;      // improved() was called in the scope
+};
+
+/**
+ * @brief Collects the SolveStats of every solve started on this thread while
+ * it lives, including the work those solves spread over the pool.
+ */
+class StatsScope {
+public:
+  explicit StatsScope(SolveStats &stats);
+  ~StatsScope();
+
+  StatsScope(const StatsScope &) = delete;
+  StatsScope &operator=(const StatsScope &) = delete;
+
+private:
+  SolveStats *previous_;
+};
+
+// Stats of the innermost StatsScope of this thread, or null. Solvers read it
+// on entry and hand it to their workers.
+#if PARTITION_STATS
+SolveStats *currentStats();
+#else
+inline SolveStats *currentStats() { return nullptr; }
+#endif
+
+/**
+ * @brief Partitions a given array into n groups using List Scheduling.
+ *
+ * Each item goes, in input order, to the currently least-loaded group (the
+ * first one on ties, for every n). Loads and assignments are kept in flat
+ * buffers; small values of n are served by compile-time kernels.
+ *
+ * @param arr The array to partition.
+ * @param n The number of groups to partition the array into.
+ * @param out Receives the group of each item and the load of each group.
+ */
+void LS(const std::vector<ValueType> &arr, std::size_t n, Assignment &out);
+
+/**
+ * @brief Returns the makespan List Scheduling reaches on values taken in the
+ * given order, without recording the assignment.
+ *
+ * Meant for fitness evaluation inside search loops: the loads live in
+ * per-thread scratch, so repeated calls do not allocate.
+ *
+ * @param values The values, in the order LS takes them.
+ * @param m The number of values.
+ * @param n The number of groups.
+ * @return The largest group load.
+ */
+ValueType lsMakespan(const ValueType *values, std::size_t m, std::size_t n);
+
+/**
+ * @brief Partitions items into n groups using List Scheduling, taking them
+ * in a given order.
+ *
+ * The k-th item placed is order[k], of value values[k]. Meant for searches
+ * that hold their best solution as an item order: the winner is written
+ * straight into out, without building the per-group view.
+ *
+ * @param values The values, in the order LS takes them.
+ * @param order The input item behind every value.
+ * @param m The number of values.
+ * @param n The number of groups.
+ * @param out Receives the group of each item and the load of each group.
+ */
+void lsOrdered(const ValueType *values, const ItemIndex *order, std::size_t m,
+               std::size_t n, Assignment &out);
+
+/**
+ * @brief Partitions a given array into n groups using Longest Processing Time.
+ *
+ * Runs LS over the items in decreasing order of value. The input is not
+ * modified.
+ *
+ * @param arr The array to partition.
+ * @param n The number of groups to partition the array into.
+ * @param out Receives the group of each item and the load of each group.
+ */
+void LPT(const std::vector<ValueType> &arr, std::size_t n, Assignment &out);
+
+/**
+ * @brief Partitions a given array into n groups using the Karmarkar-Karp
+ * largest differencing method.
+ *
+ * Starts from one partial partition per item and repeatedly merges the two
+ * whose loads are the most spread out, joining the heaviest group of one with
+ * the lightest of the other. O(m log m + m n log n); with many-bit values the
+ * error is usually far below LPT's.
+ *
+ * @param arr The array to partition.
+ * @param n The number of groups to partition the array into.
+ * @param out Receives the group of each item and the load of each group.
+ */
+void KK(const std::vector<ValueType> &arr, std::size_t n, Assignment &out);
+
+/**
+ * @brief Partitions a given array into n groups using the MULTIFIT approach.
+ *
+ * Bisects the bin capacity and packs with FFD until at most n bins are used.
+ *
+ * @param arr The array to partition.
+ * @param n The number of groups to partition the array into.
+ * @param out Receives the group of each item and the load of each group.
+ * @param k The number of iterations to run the algorithm (default is 7).
+ */
+void MULTIFIT(const std::vector<ValueType> &arr, std::size_t n,
+              Assignment &out, std::size_t k = 7);
+
+/**
+ * @brief Settings of the MULTIFIT capacity search.
+ */
+struct MultifitOptions {
+  // Search rounds (FFD probes per candidate); 0 runs until the capacity
+  // interval converges to a single integer.
+  std::size_t iterations = 7;
+  // Candidate capacities probed concurrently per round. With t candidates
+  // every round shrinks the interval by a factor of t + 1 instead of 2.
+  std::size_t threads = 1;
+};
+
+/**
+ * @brief Partitions a given array into n groups using the MULTIFIT approach
+ * with a k-ary capacity search.
+ *
+ * Every round probes options.threads evenly spaced capacities of the current
+ * interval at once on the shared thread pool. Probes only count bins, so the
+ * groups are built a single time, for the winning capacity.
+ *
+ * @param arr The array to partition.
+ * @param n The number of groups to partition the array into.
+ * @param out Receives the group of each item and the load of each group.
+ * @param options The search settings.
+ */
+void MULTIFIT(const std::vector<ValueType> &arr, std::size_t n,
+              Assignment &out, const MultifitOptions &options);
+
+/**
+ * @brief Partitions a given array into n groups using a Complete Greedy
+ * Algorithm (CGA) approach.
+ *
+ * Branch-and-bound over the LPT order, seeded with the LPT solution. The
+ * result is optimal.
+ *
+ * @param arr The array to partition.
+ * @param n The number of groups to partition the array into.
+ * @param out Receives the group of each item and the load of each group.
+ */
+void CGA(const std::vector<ValueType> &arr, std::size_t n, Assignment &out);
+
+/**
+ * @brief Settings of the CGA search.
+ */
+struct CgaOptions {
+  // Searches the tree on the shared work-stealing pool. The threads share the
+  // incumbent makespan and all stop once one of them reaches the lower bound.
+  // Ignored when the pool has a single worker.
+  bool parallel = false;
+  // Depth (number of placed items) at which subtrees stop being split into
+  // tasks and are searched sequentially; 0 picks one from the pool size.
+  std::size_t splitDepth = 0;
+};
+
+/**
+ * @brief Partitions a given array into n groups using a Complete Greedy
+ * Algorithm (CGA) approach, optionally in parallel.
+ *
+ * @param arr The array to partition.
+ * @param n The number of groups to partition the array into.
+ * @param out Receives the group of each item and the load of each group.
+ * @param options The search settings.
+ */
+void CGA(const std::vector<ValueType> &arr, std::size_t n, Assignment &out,
+         const CgaOptions &options);
+
+/**
+ * @brief Anytime CGA: returns the incumbent when control asks to stop.
+ *
+ * @param arr The array to partition.
+ * @param n The number of groups to partition the array into.
+ * @param out Receives the best solution found.
+ * @param options The search settings.
+ * @param control The deadline, cancel token and progress callback.
+ * @return Whether the search finished, which proves out optimal.
+ */
+SolveStatus CGA(const std::vector<ValueType> &arr, std::size_t n,
+                Assignment &out, const CgaOptions &options,
+                const SolveControl &control);
+
+/**
+ * @brief Partitions a given array into n groups using Recursive Number
+ * Partitioning (RNP).
+ *
+ * Exact search seeded with the better of LPT and MULTIFIT. The group of the
+ * largest remaining item is chosen among the subsets that let the other items
+ * still fit below the incumbent, and the last two groups are split by Complete
+ * Karmarkar-Karp differencing. Reaches instances with far more items than CGA
+ * when the values have many bits. The result is optimal.
+ *
+ * @param arr The array to partition.
+ * @param n The number of groups to partition the array into.
+ * @param out Receives the group of each item and the load of each group.
+ */
+void RNP(const std::vector<ValueType> &arr, std::size_t n, Assignment &out);
+
+/**
+ * @brief Anytime RNP: returns the incumbent when control asks to stop.
+ *
+ * Every failed probe of the makespan search raises the reported lower bound.
+ *
+ * @param arr The array to partition.
+ * @param n The number of groups to partition the array into.
+ * @param out Receives the best solution found.
+ * @param control The deadline, cancel token and progress callback.
+ * @return Whether out was proven optimal, and the lower bound reached.
+ */
+SolveStatus RNP(const std::vector<ValueType> &arr, std::size_t n,
+                Assignment &out, const SolveControl &control);
+
+// Memory the DP solver may use by default, in bytes.
+constexpr std::size_t DP_MEMORY_BUDGET = std::size_t{256} << 20;
+
+/**
+ * @brief Partitions a given array into n groups by dynamic programming over
+ * reachable loads.
+ *
+ * Pseudo-polynomial in the sum of the values, so meant for values with few
+ * bits. Two groups use a packed bitset of reachable subset sums; more groups
+ * use a table of reachable load vectors below the better of LPT and KK. The
+ * result is optimal.
+ *
+ * @param arr The array to partition.
+ * @param n The number of groups to partition the array into.
+ * @param out Receives the group of each item and the load of each group.
+ * @param memoryBudget The memory the tables may use, in bytes.
+ * @return false, leaving out unchanged, if the tables would exceed the budget.
+ */
+bool DP(const std::vector<ValueType> &arr, std::size_t n, Assignment &out,
+        std::size_t memoryBudget = DP_MEMORY_BUDGET);
+
+// Exact solvers selectable through solveExact. Auto runs DP for two groups
+// when its bitset fits DP_MEMORY_BUDGET and CGA otherwise.
+enum class ExactSolver { CGA, RNP, DP, Auto };
+
+/**
+ * @brief Partitions a given array into n groups with the given exact solver.
+ *
+ * @param arr The array to partition.
+ * @param n The number of groups to partition the array into.
+ * @param out Receives the group of each item and the load of each group.
+ * @param solver The exact solver to use.
+ * @param cga The settings of CGA, when it runs.
+ * @throws std::length_error If DP was requested and exceeds its budget.
+ */
+void solveExact(const std::vector<ValueType> &arr, std::size_t n,
+                Assignment &out, ExactSolver solver = ExactSolver::CGA,
+                const CgaOptions &cga = CgaOptions{});
+
+/**
+ * @brief Anytime solveExact: CGA and RNP return their incumbent when control
+ * asks to stop. DP is bounded by its memory budget instead and ignores it.
+ *
+ * @param arr The array to partition.
+ * @param n The number of groups to partition the array into.
+ * @param out Receives the best solution found.
+ * @param solver The exact solver to use.
+ * @param cga The settings of CGA, when it runs.
+ * @param control The deadline, cancel token and progress callback.
+ * @return Whether out was proven optimal, and the lower bound reached.
+ * @throws std::length_error If DP was requested and exceeds its budget.
+ */
+SolveStatus solveExact(const std::vector<ValueType> &arr, std::size_t n,
+                       Assignment &out, ExactSolver solver,
+                       const CgaOptions &cga, const SolveControl &control);
+
+/**
+ * @brief Partitions a given array into n groups using a genetic algorithm
+ * whose individuals are orderings of the values decoded by LS.
+ *
+ * @param arr The array to partition.
+ * @param n The number of groups to partition the array into.
+ * @param out Receives the group of each item and the load of each group.
+ */
+void geneticAlgorithm(const std::vector<ValueType> &arr, std::size_t n,
+                      Assignment &out);
+
+/**
+ * @brief Anytime geneticAlgorithm: stops between generations when control
+ * asks to and returns the best individual so far.
+ *
+ * @param arr The array to partition.
+ * @param n The number of groups to partition the array into.
+ * @param out Receives the best solution found.
+ * @param control The deadline, cancel token and progress callback.
+ * @return Whether out reached the lower bound max(ceil(sum / n), max item).
+ */
+SolveStatus geneticAlgorithm(const std::vector<ValueType> &arr, std::size_t n,
+                             Assignment &out, const SolveControl &control);
+
+/**
+ * @brief Settings of both genetic algorithms.
+ */
+struct GeneticOptions {
+  // Scores large generations on the shared thread pool. Off keeps the whole
+  // run on the calling thread, e.g. for timings next to other busy threads.
+  bool parallel = true;
+};
+
+/**
+ * @brief Anytime geneticAlgorithm with explicit settings.
+ *
+ * @param arr The array to partition.
+ * @param n The number of groups to partition the array into.
+ * @param out Receives the best solution found.
+ * @param options The engine settings.
+ * @param control The deadline, cancel token and progress callback.
+ * @return Whether out reached the lower bound max(ceil(sum / n), max item).
+ */
+SolveStatus geneticAlgorithm(const std::vector<ValueType> &arr, std::size_t n,
+                             Assignment &out, const GeneticOptions &options,
+                             const SolveControl &control = SolveControl{});
+
+/**
+ * @brief Partitions a given array into n groups using a random-key genetic
+ * algorithm decoded by LS.
+ *
+ * @param arr The array to partition.
+ * @param n The number of groups to partition the array into.
+ * @param out Receives the group of each item and the load of each group.
+ */
+void geneticAlgorithm2(const std::vector<ValueType> &arr, std::size_t n,
+                       Assignment &out);
+
+/**
+ * @brief Anytime geneticAlgorithm2, stopped between generations.
+ *
+ * @param arr The array to partition.
+ * @param n The number of groups to partition the array into.
+ * @param out Receives the best solution found.
+ * @param control The deadline, cancel token and progress callback.
+ * @return Whether out reached the lower bound max(ceil(sum / n), max item).
+ */
+SolveStatus geneticAlgorithm2(const std::vector<ValueType> &arr,
+                              std::size_t n, Assignment &out,
+                              const SolveControl &control);
+
+/**
+ * @brief Anytime geneticAlgorithm2 with explicit settings.
+ *
+ * @param arr The array to partition.
+ * @param n The number of groups to partition the array into.
+ * @param out Receives the best solution found.
+ * @param options The engine settings.
+ * @param control The deadline, cancel token and progress callback.
+ * @return Whether out reached the lower bound max(ceil(sum / n), max item).
+ */
+SolveStatus geneticAlgorithm2(const std::vector<ValueType> &arr,
+                              std::size_t n, Assignment &out,
+                              const GeneticOptions &options,
+                              const SolveControl &control = SolveControl{});
+
+/**
+ * @brief Partitions a given array into n groups using simulated annealing
+ * started from the LPT solution.
+ *
+ * @param arr The array to partition.
+ * @param n The number of groups to partition the array into.
+ * @param out Receives the group of each item and the load of each group.
+ */
+void SimulatedAnnealing(const std::vector<ValueType> &arr, std::size_t n,
+                        Assignment &out);
+
+/**
+ * @brief Settings of the multi-start simulated annealing.
+ */
+struct AnnealingOptions {
+  // Independent chains run on the shared thread pool; 0 starts one per
+  // worker. Chain 0 keeps the default schedule and the others spread their
+  // starting temperatures over a ladder around it.
+  std::size_t chains = 1;
+  // Seed of the random streams (one per chain); 0 draws a random one.
+  uint64_t seed = 0;
+};
+
+/**
+ * @brief Partitions a given array into n groups with several simulated
+ * annealing chains started from the LPT solution.
+ *
+ * The chains share the best makespan found so far and all stop once it
+ * reaches the lower bound max(ceil(sum / n), max item). The best solution of
+ * any chain is returned.
+ *
+ * @param arr The array to partition.
+ * @param n The number of groups to partition the array into.
+ * @param out Receives the group of each item and the load of each group.
+ * @param options The chain settings.
+ */
+void SimulatedAnnealing(const std::vector<ValueType> &arr, std::size_t n,
+                        Assignment &out, const AnnealingOptions &options);
+
+/**
+ * @brief Anytime SimulatedAnnealing: every chain stops between temperatures
+ * when control asks to, and the best solution of any chain is returned.
+ *
+ * @param arr The array to partition.
+ * @param n The number of groups to partition the array into.
+ * @param out Receives the best solution found.
+ * @param options The chain settings.
+ * @param control The deadline, cancel token and progress callback.
+ * @return Whether out reached the lower bound max(ceil(sum / n), max item).
+ */
+SolveStatus SimulatedAnnealing(const std::vector<ValueType> &arr,
+                               std::size_t n, Assignment &out,
+                               const AnnealingOptions &options,
+                               const SolveControl &control);
+
+// Item that changes groups in a rebalance plan.
+struct Migration {
+  ItemIndex item;
+  GroupIndex from;
+  GroupIndex to;
+};
+
+/**
+ * @brief Settings of a rebalance from an existing assignment.
+ */
+struct MigrationOptions {
+  // Most items that may end up outside their current group.
+  std::size_t budget = std::numeric_limits<std::size_t>::max();
+  // Price of one migrated item in makespan units: the plan minimizes
+  // makespan + moveCost * migrations. 0 only breaks ties on the makespan.
+  ValueType moveCost = 0;
+  // Seed of the annealing stream; 0 draws a random one.
+  uint64_t seed = 0;
+};
+
+/**
+ * @brief Finds the items to migrate so that an existing assignment gets a
+ * lower makespan without moving more than the budget allows.
+ *
+ * Starts from current and runs a descent of moves and swaps out of the
+ * heaviest group, then the simulated annealing neighbourhood on makespan +
+ * moveCost * migrations, and finally sends back home every item whose return
+ * does not make the plan costlier. The search stops once the makespan reaches
+ * the lower bound, which also accounts for the budget: no group can shed
+ * more than its budget largest items.
+ *
+ * @param arr The sizes of the items.
+ * @param current The group of every item today; loads gives the group count
+ * and is recomputed from groupOf.
+ * @param moves Receives one entry per item that changes groups, by item.
+ * @param options The budget, cost and seed.
+ * @param control The deadline, cancel token and progress callback.
+ * @return Whether the plan reaches the lower bound.
+ * @throws std::invalid_argument If current has no groups or does not match
+ * arr.
+ */
+SolveStatus rebalance(const std::vector<ValueType> &arr,
+                      const Assignment &current, std::vector<Migration> &moves,
+                      const MigrationOptions &options = MigrationOptions{},
+                      const SolveControl &control = SolveControl{});
+
+// Solvers a portfolio can race.
+enum class Solver { LS, LPT, KK, MULTIFIT, CGA, RNP, DP, GA, GA2, SA };
+
+/**
+ * @brief Returns the name of a solver, as used in the result columns.
+ */
+const char *solverName(Solver solver);
+
+/**
+ * @brief Settings of the solver portfolio.
+ */
+struct PortfolioOptions {
+  // Solvers to race, one task each; earlier ones start first on the calling
+  // thread. Duplicates run independently.
+  std::vector<Solver> solvers = {Solver::LPT, Solver::KK, Solver::MULTIFIT,
+                                 Solver::SA, Solver::CGA};
+  // Settings of CGA; parallel is ignored, the race searches sequentially.
+  CgaOptions cga;
+  AnnealingOptions annealing; // settings of SA
+};
+
+/**
+ * @brief Outcome of a portfolio race.
+ */
+struct PortfolioResult {
+  Solver winner = Solver::LPT; // solver whose solution was returned
+  // Time from the start of the race until the winner returned
+  SolveControl::Clock::duration elapsed{};
+  SolveStatus status; // optimality, interruption and lower bound of the race
+};
+
+/**
+ * @brief Races several solvers on the shared thread pool and keeps the best
+ * solution.
+ *
+ * The solvers share the incumbent and the lower bound through their progress
+ * reports. All of them are cancelled as soon as the incumbent reaches the
+ * lower bound, a solver proves its solution optimal, or control asks to
+ * stop. LS, LPT, KK, MULTIFIT and DP cannot be interrupted, but are short.
+ * A DP over its memory budget drops out of the race. Nested parallel solvers
+ * are not supported, so CGA searches sequentially inside the race.
+ *
+ * @param arr The array to partition.
+ * @param n The number of groups to partition the array into.
+ * @param out Receives the best solution found.
+ * @param options The solvers to race and their settings.
+ * @param control The deadline, cancel token and progress callback of the
+ * whole race.
+ * @return The winning solver, when it returned and the status of the race.
+ */
+PortfolioResult portfolio(const std::vector<ValueType> &arr, std::size_t n,
+                          Assignment &out,
+                          const PortfolioOptions &options = PortfolioOptions{},
+                          const SolveControl &control = SolveControl{});
+
+/**
+ * @brief Incremental partition of items that arrive and leave over time.
+ *
+ * add() places an item on the least-loaded group, the first one on ties, as
+ * every LS kernel does: adding items one by one gives the same groups as LS
+ * over them in that order, for any n. Loads are
+ * kept in a flat tree that yields both the lightest and the heaviest group,
+ * so add() and remove() take O(log n). rebalance() improves the live state
+ * with a bounded number of moves and swaps between the heaviest and the
+ * lightest group.
+ *
+ * Item ids are dense and the ids of removed items are reused by later adds.
+ */
+class OnlinePartitioner {
+public:
+  // Where add() put an item.
+  struct Placement {
+    ItemIndex item;
+    GroupIndex group;
+  };
+
+  /**
+   * @param n The number of groups.
+   * @throws std::invalid_argument If n is 0.
+   */
+  explicit OnlinePartitioner(std::size_t n);
+
+  /**
+   * @brief Places an item on the least-loaded group (the first one on ties).
+   *
+   * @param value The size of the item.
+   * @return The id given to the item and its group.
+   */
+  Placement add(ValueType value);
+
+  /**
+   * @brief Takes a live item out of its group.
+   *
+   * @throws std::out_of_range If item is not a live item.
+   */
+  void remove(ItemIndex item);
+
+  /**
+   * @brief Runs at most budget improvement steps on the live state.
+   *
+   * Every step either moves one item from the heaviest group to the
+   * lightest, or swaps one item of each, choosing the change that leaves the
+   * two loads closest; a change is only made when both new loads are below
+   * the old maximum. Stops early once no such change exists.
+   *
+   * @param budget The most steps to run.
+   * @return The number of items that changed groups.
+   */
+  std::size_t rebalance(std::size_t budget);
+
+  // Group of a live item; throws std::out_of_range otherwise.
+  GroupIndex groupOf(ItemIndex item) const;
+  // Size of a live item; throws std::out_of_range otherwise.
+  ValueType value(ItemIndex item) const;
+  // Live items of group g, in no particular order.
+  const std::vector<ItemIndex> &members(GroupIndex g) const {
+    return members_[g];
+  }
+  ValueType load(GroupIndex g) const { return maxKey_[leaves_ + g]; }
+  ValueType makespan() const { return maxKey_[1]; }
+  std::size_t groups() const { return members_.size(); }
+  // Number of live items.
+  std::size_t size() const { return values_.size() - freeIds_.size(); }
+
+private:
+  void setLoad(GroupIndex g, ValueType load);
+  void place(ItemIndex item, GroupIndex g);
+  void unplace(ItemIndex item);
+  void checkLive(ItemIndex item) const;
+
+  std::vector<ValueType> values_;              // item -> size
+  std::vector<GroupIndex> groupOf_;            // item -> group, or none
+  std::vector<uint32_t> position_;             // item -> index in members_
+  std::vector<std::vector<ItemIndex>> members_; // group -> live items
+  std::vector<ItemIndex> freeIds_;              // ids of removed items
+
+  // Tree over the loads: node p keeps the lightest and the heaviest group of
+  // its subtree (the leftmost on ties); leaves start at leaves_.
+  std::size_t leaves_ = 1;
+  std::vector<ValueType> minKey_, maxKey_;
+  std::vector<GroupIndex> minSlot_, maxSlot_;
+};
+
+/**
+ * @brief Builds the per-group view of an assignment.
+ *
+ * @param arr The array that was partitioned.
+ * @param assignment The index-based solution for arr.
+ * @return One vector per group with the values assigned to it.
+ */
+Groups toGroups(const std::vector<ValueType> &arr,
+                const Assignment &assignment);
+
+/**
+ * @brief Per-group adapter over LS(arr, n, out).
+ *
+ * @param arr The array to partition.
+ * @param n The number of groups to partition the array into.
+ * @return The n partitioned groups of the array.
+ */
+Groups LS(const std::vector<ValueType> &arr, std::size_t n);
+
+/**
+ * @brief Per-group adapter over LPT(arr, n, out).
+ *
+ * @param arr The array to partition.
+ * @param n The number of groups to partition the array into.
+ * @return The n partitioned groups of the array.
+ */
+Groups LPT(const std::vector<ValueType> &arr, std::size_t n);
+
+/**
+ * @brief Per-group adapter over KK(arr, n, out).
+ *
+ * @param arr The array to partition.
+ * @param n The number of groups to partition the array into.
+ * @return The n partitioned groups of the array.
+ */
+Groups KK(const std::vector<ValueType> &arr, std::size_t n);
+
+/**
+ * @brief Per-group adapter over MULTIFIT(arr, n, out, k).
+ *
+ * @param arr The array to partition.
+ * @param n The number of groups to partition the array into.
+ * @param k The number of iterations to run the algorithm (default is 7).
+ * @return The n partitioned groups of the array.
+ */
+Groups MULTIFIT(const std::vector<ValueType> &arr, std::size_t n,
+                std::size_t k = 7);
+
+/**
+ * @brief Template function to partition a given array into groups using the
+ * FFD algorithm.
+ *
+ * This function implements the FFD algorithm to find the optimal partition of
+ * the array into groups.
+ *
+ * @param arr The array to partition.
+ * @return An array of vectors containing the partitioned groups of the array.
+ */
+std::vector<std::vector<ValueType>> FFD(const std::vector<ValueType> &arr,
+                                        ValueType capacity);
+
+/**
+ * @brief Per-group adapter over CGA(arr, n, out).
+ *
+ * @param arr The array to partition.
+ * @param n The number of groups to partition the array into.
+ * @return The n partitioned groups of the array.
+ */
+Groups CGA(const std::vector<ValueType> &arr, std::size_t n);
+
+/**
+ * @brief Per-group adapter over RNP(arr, n, out).
+ *
+ * @param arr The array to partition.
+ * @param n The number of groups to partition the array into.
+ * @return The n partitioned groups of the array.
+ */
+Groups RNP(const std::vector<ValueType> &arr, std::size_t n);
+
+/**
+ * @brief Per-group adapter over geneticAlgorithm(arr, n, out).
+ *
+ * @param arr The array to partition.
+ * @param n The number of groups to partition the array into.
+ * @return The n partitioned groups of the array.
+ */
+Groups geneticAlgorithm(const std::vector<ValueType> &arr, std::size_t n);
+
+/**
+ * @brief Per-group adapter over geneticAlgorithm2(arr, n, out).
+ *
+ * @param arr The array to partition.
+ * @param n The number of groups to partition the array into.
+ * @return The n partitioned groups of the array.
+ */
+Groups geneticAlgorithm2(const std::vector<ValueType> &arr, std::size_t n);
+
+/**
+ * @brief Per-group adapter over SimulatedAnnealing(arr, n, out).
+ *
+ * @param arr The array to partition.
+ * @param n The number of groups to partition the array into.
+ * @return The n partitioned groups of the array.
+ */
+Groups SimulatedAnnealing(const std::vector<ValueType> &arr, std::size_t n);
+
 /**
  * @brief Template function to partition a given array into n groups.
  *
+ * Fixed-n adapter over LS(arr, n).
+ *
  * @param n The number of groups to partition the array into.
  * @param arr The array to partition.
  * @return An array of vectors containing the partitioned groups of the array.
  */
 template <std::size_t n>
-std::array<std::vector<ValueType>, n> LS(std::vector<ValueType> &arr);
+std::array<std::vector<ValueType>, n> LS(const std::vector<ValueType> &arr);
 
 /**
  * @brief Template function to partition a given array into n groups.
+ *
+ * Fixed-n adapter over LPT(arr, n).
+ *
  * @param n The number of groups to partition the array into.
  * @param arr The array to partition.
  * @return An array of vectors containing the partitioned groups of the array.
  */
 template <std::size_t n>
-std::array<std::vector<ValueType>, n> LPT(std::vector<ValueType> &arr);
+std::array<std::vector<ValueType>, n> LPT(const std::vector<ValueType> &arr);
 
 /**
- * @brief Template function to partition a given array into n groups using a
- * multifit approach.
+ * @brief Template function to partition a given array into n groups using the
+ * Karmarkar-Karp differencing method.
  *
- * This function implements a dynamic programming approach to find the optimal
- * partition of the array into n groups.
+ * Fixed-n adapter over KK(arr, n).
  *
- * @param n The number of groups to partition the array into.
  * @param arr The array to partition.
- * @param k The number of iterations to run the algorithm (default is 7).
  * @return An array of vectors containing the partitioned groups of the array.
  */
 template <std::size_t n>
-std::array<std::vector<ValueType>, n> MULTIFIT(std::vector<ValueType> &arr,
-                                               std::size_t k = 7);
+std::array<std::vector<ValueType>, n> KK(const std::vector<ValueType> &arr);
 
 /**
- * @brief Template function to partition a given array into groups using the
- * FFD algorithm.
+ * @brief Template function to partition a given array into n groups using a
+ * multifit approach.
  *
- * This function implements the FFD algorithm to find the optimal partition of
- * the array into groups.
+ * Fixed-n adapter over MULTIFIT(arr, n, k).
  *
+ * @param n The number of groups to partition the array into.
  * @param arr The array to partition.
+ * @param k The number of iterations to run the algorithm (default is 7).
  * @return An array of vectors containing the partitioned groups of the array.
  */
-std::vector<std::vector<ValueType>> FFD(std::vector<ValueType> &arr,
-                                        ValueType capacity);
+template <std::size_t n>
+std::array<std::vector<ValueType>, n>
+MULTIFIT(const std::vector<ValueType> &arr, std::size_t k = 7);
 
 /**
  * @brief Template function to partition a given array into n groups using a
  * Complete Greedy Algorithm (CGA) approach.
  *
- * This function implements a complete greedy algorithm to find the optimal
- * partition of the array into n groups.
+ * Fixed-n adapter over CGA(arr, n).
  *
  * @param arr The array to partition.
  * @return An array of vectors containing the partitioned groups of the array.
  */
 template <std::size_t n>
-std::array<std::vector<ValueType>, n> CGA(std::vector<ValueType> &arr);
+std::array<std::vector<ValueType>, n> CGA(const std::vector<ValueType> &arr);
 
 /**
- * @brief A backtracking algorithm to find the optimal partition of the array
- * into n groups using a Complete Greedy Algorithm (CGA) approach.
+ * @brief Template function to partition a given array into n groups using
+ * Recursive Number Partitioning.
  *
- * This function implements a backtracking algorithm to find the optimal
- * partition of the array into n groups. It uses a complete greedy
- * algorithm to find the optimal partition.
+ * Fixed-n adapter over RNP(arr, n).
  *
  * @param arr The array to partition.
- * @param groups The current partition of the array.
- * @param groupSums The sum of each group in the current partition.
- * @param makespan The maximum difference between the sums of the groups.
- * @param lowerbound The lower bound of the makespan.
- * @param groupsCandidate The current candidate partition.
- * @param i The current index in the array.
+ * @return An array of vectors containing the partitioned groups of the array.
  */
 template <std::size_t n>
-void CGABacktracking(const std::vector<ValueType> &arr,
-                     std::array<std::vector<ValueType>, n> &actualGroups,
-                     std::array<ValueType, n> &groupSums, ValueType &makespan,
-                     ValueType &lowerbound,
-                     std::array<std::vector<ValueType>, n> &groupsCandidate,
-                     std::size_t i);
+std::array<std::vector<ValueType>, n> RNP(const std::vector<ValueType> &arr);
 
 /**
  * @brief Template function to partition a given array into n groups using a
  * genetic algorithm approach.
  *
- * This function implements a genetic algorithm to find the optimal partition
- * of the array into n groups.
+ * Fixed-n adapter over geneticAlgorithm(arr, n).
  *
  * @param arr The array to partition.
  * @return An array of vectors containing the partitioned groups of the array.
  */
 template <std::size_t n>
 std::array<std::vector<ValueType>, n>
-geneticAlgorithm(std::vector<ValueType> &arr);
+geneticAlgorithm(const std::vector<ValueType> &arr);
 
 template <std::size_t n>
 std::array<std::vector<ValueType>, n>
-geneticAlgorithm2(std::vector<ValueType> &arr);
+geneticAlgorithm2(const std::vector<ValueType> &arr);
 
 template <std::size_t n>
 std::array<std::vector<ValueType>, n>
-SimulatedAnnealing(std::vector<ValueType> &arr);
+SimulatedAnnealing(const std::vector<ValueType> &arr);
 } // namespace partition
 
 #include "Partition.tpp"
@@ -0,0 +1,195 @@
+#include "Partition.hpp"
+#include "ThreadPool.hpp"
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+
+namespace partition {
+
+namespace {
+// State of one portfolio race, shared by the tasks of its solvers.
+struct Race {
+  const SolveControl &control;
+  SolveControl::Clock::time_point start;
+  std::atomic<bool> stop{false}; // cancels every solver still running
+  std::mutex mutex;              // guards everything below
+  ValueType incumbent;
+  ValueType lowerBound;
+  bool proven = false;           // some solver proved its solution optimal
+  std::size_t winner;            // index of the best finished solver
+  SolveControl::Clock::duration elapsed{};
+
+  Race(const SolveControl &control, ValueType lowerBound)
+      : control(control), start(SolveControl::Clock::now()),
+        incumbent(std::numeric_limits<ValueType>::max()),
+        lowerBound(lowerBound), winner(std::numeric_limits<std::size_t>::max()) {
+  }
+
+  // Folds a progress report of any solver into the shared bounds. Called
+  // with the lock held.
+  void improve(ValueType makespan, ValueType bound) {
+    lowerBound = std::max(lowerBound, bound);
+    if (makespan < incumbent) {
+      incumbent = makespan;
+      control.report(start, incumbent, lowerBound);
+    }
+    if (proven || incumbent <= lowerBound) {
+      stop.store(true, std::memory_order_relaxed);
+    }
+  }
+};
+
+// Runs one solver under control. Returns false when it gave no solution.
+bool runSolver(Solver solver, const std::vector<ValueType> &arr,
+               std::size_t n, Assignment &out, const PortfolioOptions &options,
+               const SolveControl &control, SolveStatus &status) {
+  switch (solver) {
+  case Solver::LS:
+    LS(arr, n, out);
+    return true;
+  case Solver::LPT:
+    LPT(arr, n, out);
+    return true;
+  case Solver::KK:
+    KK(arr, n, out);
+    return true;
+  case Solver::MULTIFIT:
+    MULTIFIT(arr, n, out);
+    return true;
+  case Solver::CGA: {
+    // The race already fills the pool; a nested parallel search would share
+    // it with the other solvers of the race
+    CgaOptions cga = options.cga;
+    cga.parallel = false;
+    status = CGA(arr, n, out, cga, control);
+    return true;
+  }
+  case Solver::RNP:
+    status = RNP(arr, n, out, control);
+    return true;
+  case Solver::DP:
+    if (!DP(arr, n, out)) {
+      return false;
+    }
+    status.optimal = true;
+    status.lowerBound = out.makespan;
+    return true;
+  case Solver::GA:
+    status = geneticAlgorithm(arr, n, out, control);
+    return true;
+  case Solver::GA2:
+    status = geneticAlgorithm2(arr, n, out, control);
+    return true;
+  case Solver::SA:
+    status = SimulatedAnnealing(arr, n, out, options.annealing, control);
+    return true;
+  }
+  return false;
+}
+} // namespace
+
+const char *solverName(Solver solver) {
+  switch (solver) {
+  case Solver::LS:
+    return "LS";
+  case Solver::LPT:
+    return "LPT";
+  case Solver::KK:
+    return "KK";
+  case Solver::MULTIFIT:
+    return "MULTIFIT";
+  case Solver::CGA:
+    return "CGA";
+  case Solver::RNP:
+    return "RNP";
+  case Solver::DP:
+    return "DP";
+  case Solver::GA:
+    return "Genetic";
+  case Solver::GA2:
+    return "Genetic2";
+  case Solver::SA:
+    return "SA";
+  }
+  return "?";
+}
+
+PortfolioResult portfolio(const std::vector<ValueType> &arr, std::size_t n,
+                          Assignment &out, const PortfolioOptions &options,
+                          const SolveControl &control) {
+  if (n == 0) {
+    throw std::invalid_argument("n must be a positive integer");
+  }
+
+  ValueType lowerBound = 0;
+  if (!arr.empty()) {
+    ValueType sum = std::accumulate(arr.begin(), arr.end(), ValueType{0});
+    lowerBound = std::max((sum + n - 1) / n,
+                          *std::max_element(arr.begin(), arr.end()));
+  }
+
+  const std::size_t count = options.solvers.size();
+  Race race(control, lowerBound);
+  std::vector<Assignment> results(count);
+
+  auto run = [&](std::size_t s) {
+    if (race.stop.load(std::memory_order_relaxed) || control.stopRequested()) {
+      return;
+    }
+
+    SolveControl own;
+    own.cancel = &race.stop;
+    own.parent = &control;
+    own.progress = [&race](SolveControl::Clock::duration, ValueType makespan,
+                           ValueType bound) {
+      std::lock_guard<std::mutex> lock(race.mutex);
+      race.improve(makespan, bound);
+    };
+
+    SolveStatus status;
+    if (!runSolver(options.solvers[s], arr, n, results[s], options, own,
+                   status)) {
+      return;
+    }
+
+    std::lock_guard<std::mutex> lock(race.mutex);
+    bool better = race.winner == std::numeric_limits<std::size_t>::max() ||
+                  results[s].makespan < results[race.winner].makespan;
+    if (better) {
+      race.winner = s;
+      race.elapsed = SolveControl::Clock::now() - race.start;
+    }
+    race.proven = race.proven || status.optimal;
+    race.improve(results[s].makespan, status.lowerBound);
+  };
+
+  // Tasks queued from this thread are taken back newest first, so queue them
+  // in reverse for the first solvers to start first
+  TaskGroup group(ThreadPool::shared());
+  for (std::size_t s = count; s-- > 0;) {
+    group.run([&run, s] { run(s); });
+  }
+  group.wait();
+
+  PortfolioResult result;
+  if (race.winner == std::numeric_limits<std::size_t>::max()) {
+    // Nothing finished (stopped before starting, or only DP over budget)
+    LPT(arr, n, out);
+    result.elapsed = SolveControl::Clock::now() - race.start;
+  } else {
+    out = std::move(results[race.winner]);
+    result.winner = options.solvers[race.winner];
+    result.elapsed = race.elapsed;
+  }
+
+  result.status.lowerBound = race.lowerBound;
+  result.status.optimal = race.proven || out.makespan <= race.lowerBound;
+  result.status.interrupted =
+      !result.status.optimal && control.stopRequested();
+  if (result.status.optimal) {
+    result.status.lowerBound = out.makespan;
+  }
+  return result;
+}
+} // namespace partition
@@ -1,84 +1,432 @@
 #include "ReadInstances.hpp"
+#include <charconv>
+#include <cstring>
 #include <fstream>
 #include <iostream>
+#include <iterator>
 #include <sstream>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define READINSTANCES_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 namespace ReadInstances {
 
-std::vector<InstanceData> readInstances(const std::string &filePath) {
-  std::ifstream file(filePath);
-  std::vector<InstanceData> instances;
+namespace {
+const char *skipSpaces(const char *p, const char *end) {
+  while (p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')) {
+    p++;
+  }
+  return p;
+}
+
+const char *skipLine(const char *p, const char *end) {
+  const void *newline = std::memchr(p, '\n', end - p);
+  return newline ? static_cast<const char *>(newline) + 1 : end;
+}
+
+// Skips the rest of a broken instance, up to the next comment line.
+const char *skipInstance(const char *p, const char *end) {
+  for (p = skipLine(p, end); p < end; p = skipLine(p, end)) {
+    p = skipSpaces(p, end);
+    if (p == end || *p == '#') {
+      break;
+    }
+  }
+  return p;
+}
+
+// Parses the next number of the current instance into value. Fails at the
+// end of the input, on a comment line or on anything that is not a number.
+template <typename T> bool parseNumber(const char *&p, const char *end, T &value) {
+  p = skipSpaces(p, end);
+  if (p == end || *p == '#') {
+    return false;
+  }
+  auto result = std::from_chars(p, end, value);
+  if (result.ec != std::errc()) {
+    return false;
+  }
+  p = result.ptr;
+  return true;
+}
 
+const char BINARY_MAGIC[8] = {'N', 'P', 'A', 'R', 'T', 'B', 'I', 'N'};
+const std::uint32_t BINARY_VERSION = 1;
+const std::size_t BINARY_HEADER_SIZE = 32;
+
+// Bytes of the table per instance: offset, optimalSum, M, N, B and width
+const std::size_t BINARY_ROW_SIZE = 8 + 8 + 4 + 4 + 4 + 1;
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+const bool LITTLE_ENDIAN_HOST = true;
+#else
+const bool LITTLE_ENDIAN_HOST = false;
+#endif
+
+// Little-endian encoding of the width low bytes of value.
+void putLE(unsigned char *out, std::uint64_t value, std::size_t width) {
+  for (std::size_t b = 0; b < width; b++) {
+    out[b] = static_cast<unsigned char>(value >> (8 * b));
+  }
+}
+
+std::uint64_t getLE(const unsigned char *in, std::size_t width) {
+  std::uint64_t value = 0;
+  for (std::size_t b = width; b-- > 0;) {
+    value = (value << 8) | in[b];
+  }
+  return value;
+}
+
+template <typename T> void appendLE(std::vector<unsigned char> &out, T value) {
+  std::size_t at = out.size();
+  out.resize(at + sizeof(T));
+  putLE(out.data() + at, value, sizeof(T));
+}
+
+// Smallest of 1, 2, 4 or 8 bytes that holds every value.
+std::size_t valueWidth(const ValueSpan &values) {
+  partition::ValueType max = 0;
+  for (partition::ValueType value : values) {
+    max |= value;
+  }
+  std::size_t width = 1;
+  while (width < 8 && (max >> (8 * width)) != 0) {
+    width *= 2;
+  }
+  return width;
+}
+
+std::uint64_t padTo8(std::uint64_t size) { return (size + 7) & ~std::uint64_t(7); }
+} // namespace
+
+void InstanceView::copyTo(InstanceData &out) const {
+  out.M = M;
+  out.N = N;
+  out.B = B;
+  out.optimalSum = optimalSum;
+  out.values.assign(values.begin(), values.end());
+}
+
+InstanceData InstanceView::toOwned() const {
+  InstanceData out;
+  copyTo(out);
+  return out;
+}
+
+MappedFile::MappedFile(const std::string &filePath, bool sequential) {
+#ifdef READINSTANCES_MMAP
+  int fd = ::open(filePath.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Could not open file: " + filePath);
+  }
+  struct stat info;
+  if (::fstat(fd, &info) != 0) {
+    ::close(fd);
+    throw std::runtime_error("Could not stat file: " + filePath);
+  }
+
+  size_ = static_cast<std::size_t>(info.st_size);
+  if (size_ > 0) {
+    void *mapping = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping == MAP_FAILED) {
+      ::close(fd);
+      throw std::runtime_error("Could not map file: " + filePath);
+    }
+    ::madvise(mapping, size_, sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+    data_ = static_cast<const char *>(mapping);
+  } else {
+    data_ = fallback_.data();
+  }
+  ::close(fd);
+#else
+  (void)sequential;
+  std::ifstream file(filePath, std::ios::binary);
   if (!file.is_open()) {
-    std::cerr << "[ERROR] Could not open file: " << filePath << std::endl;
-    return instances;
+    throw std::runtime_error("Could not open file: " + filePath);
+  }
+  fallback_.assign(std::istreambuf_iterator<char>(file),
+                   std::istreambuf_iterator<char>());
+  data_ = fallback_.data();
+  size_ = fallback_.size();
+#endif
+}
+
+MappedFile::~MappedFile() {
+#ifdef READINSTANCES_MMAP
+  if (size_ > 0) {
+    ::munmap(const_cast<char *>(data_), size_);
   }
+#endif
+}
 
-  std::string line;
-  InstanceData current;
-  bool readingValues = false;
-  int valuesCount = 0;
+InstanceStream::InstanceStream(const std::string &filePath)
+    : file_(filePath) {}
 
-  while (std::getline(file, line)) {
-    // Skip empty lines
-    if (line.empty())
-      continue;
+InstanceStream::iterator InstanceStream::begin() const {
+  iterator it(this, file_.data());
+  return ++it;
+}
 
-    // Check if it's an instance header
-    if (line.find("# Instance") != std::string::npos) {
-      // If we were reading an instance, save it before starting a new one
-      if (readingValues && valuesCount == current.M) {
-        instances.push_back(current);
-      }
+InstanceStream::iterator InstanceStream::end() const {
+  return iterator(this, nullptr);
+}
+
+InstanceStream::iterator::iterator(const InstanceStream *stream,
+                                   const char *at)
+    : stream_(stream), at_(at), next_(at) {}
+
+std::size_t InstanceStream::iterator::offset() const {
+  const MappedFile &file = stream_->file_;
+  return at_ ? std::size_t(next_ - file.data()) : file.size();
+}
+
+InstanceStream::iterator &InstanceStream::iterator::operator++() {
+  const char *end = stream_->file_.data() + stream_->file_.size();
+  const char *p = next_;
+
+  while (true) {
+    p = skipSpaces(p, end);
+    if (p == end) {
+      at_ = next_ = nullptr;
+      return *this;
+    }
 
-      // Reset for new instance
-      current = InstanceData();
-      readingValues = false;
-      valuesCount = 0;
+    // "# Instance X" headers (and any other comment line)
+    if (*p == '#') {
+      p = skipLine(p, end);
       continue;
     }
 
     // Read the parameters line (N K B optimalSum)
-    if (!readingValues && line.find("#") == std::string::npos) {
-      std::istringstream iss(line);
-      if (iss >> current.M >> current.N >> current.B >> current.optimalSum) {
-        if (current.M <= 0) {
-          std::cerr << "[ERRO] Valor de M inválido: " << current.M << "\n";
-          continue;
-        }
-        current.values.clear();
-        readingValues = true;
-      } else {
-        std::cerr << "[ERRO] Linha mal formatada: " << line << "\n";
-      }
+    const char *start = p;
+    InstanceView view{};
+    if (!parseNumber(p, end, view.M) || !parseNumber(p, end, view.N) ||
+        !parseNumber(p, end, view.B) ||
+        !parseNumber(p, end, view.optimalSum)) {
+      const char *lineEnd = skipLine(start, end);
+      std::cerr << "[ERRO] Linha mal formatada: "
+                << std::string(start, lineEnd - start);
+      p = skipInstance(start, end);
+      continue;
+    }
+    if (view.M <= 0) {
+      std::cerr << "[ERRO] Valor de M inválido: " << view.M << "\n";
+      p = skipInstance(start, end);
       continue;
     }
 
-    // Read the values line
-    if (readingValues) {
-      std::istringstream iss(line);
-      partition::ValueType value;
-      while (iss >> value) {
-        current.values.push_back(value);
-        valuesCount++;
-      }
+    // Read the values, over as many lines as they take
+    values_.resize(view.M);
+    int count = 0;
+    while (count < view.M && parseNumber(p, end, values_[count])) {
+      count++;
+    }
+    if (count < view.M) {
+      std::cerr << "[ERRO] Instância incompleta ignorada.\n";
+      continue;
+    }
 
-      // Check if we read all expected values
-      if (valuesCount == current.N) {
-        instances.push_back(current);
-        readingValues = false;
-      }
+    view_ = view;
+    at_ = start;
+    next_ = p;
+    return *this;
+  }
+}
+
+BinaryInstances::BinaryInstances(const std::string &filePath)
+    : file_(filePath, false) {
+  const auto *data = reinterpret_cast<const unsigned char *>(file_.data());
+  if (file_.size() < BINARY_HEADER_SIZE ||
+      std::memcmp(data, BINARY_MAGIC, sizeof(BINARY_MAGIC)) != 0) {
+    throw std::runtime_error("Not a binary instance file: " + filePath);
+  }
+  if (getLE(data + 8, 4) != BINARY_VERSION) {
+    throw std::runtime_error("Unsupported binary instance version: " +
+                             filePath);
+  }
+
+  std::uint64_t count = getLE(data + 16, 8);
+  std::uint64_t table = getLE(data + 24, 8);
+  if (table < BINARY_HEADER_SIZE || table > file_.size() ||
+      count > (file_.size() - table) / BINARY_ROW_SIZE) {
+    throw std::runtime_error("Truncated binary instance file: " + filePath);
+  }
+  count_ = static_cast<std::size_t>(count);
+  table_ = data + table;
+}
+
+InstanceView BinaryInstances::view(std::size_t i,
+                                   std::vector<partition::ValueType> &buffer) const {
+  if (i >= count_) {
+    throw std::out_of_range("Instance index out of range");
+  }
+
+  // Columns follow each other in the table
+  const unsigned char *offsets = table_;
+  const unsigned char *optimalSums = offsets + 8 * count_;
+  const unsigned char *Ms = optimalSums + 8 * count_;
+  const unsigned char *Ns = Ms + 4 * count_;
+  const unsigned char *Bs = Ns + 4 * count_;
+  const unsigned char *widths = Bs + 4 * count_;
+
+  InstanceView view{};
+  view.M = static_cast<int>(getLE(Ms + 4 * i, 4));
+  view.N = static_cast<int>(getLE(Ns + 4 * i, 4));
+  view.B = static_cast<int>(getLE(Bs + 4 * i, 4));
+  view.optimalSum = getLE(optimalSums + 8 * i, 8);
+
+  std::uint64_t offset = getLE(offsets + 8 * i, 8);
+  std::size_t width = widths[i];
+  std::size_t size = static_cast<std::size_t>(view.M);
+  const auto *data = reinterpret_cast<const unsigned char *>(file_.data());
+  if ((width != 1 && width != 2 && width != 4 && width != 8) ||
+      offset < BINARY_HEADER_SIZE ||
+      offset > std::uint64_t(table_ - data) ||
+      size > (std::uint64_t(table_ - data) - offset) / width) {
+    throw std::runtime_error("Corrupt binary instance " + std::to_string(i));
+  }
+
+  const unsigned char *values = data + offset;
+  if (width == sizeof(partition::ValueType) && LITTLE_ENDIAN_HOST &&
+      reinterpret_cast<std::uintptr_t>(values) %
+              alignof(partition::ValueType) == 0) {
+    view.values = ValueSpan{
+        reinterpret_cast<const partition::ValueType *>(values), size};
+    return view;
+  }
+
+  buffer.resize(size);
+  for (std::size_t k = 0; k < size; k++) {
+    buffer[k] = getLE(values + k * width, width);
+  }
+  view.values = ValueSpan{buffer.data(), size};
+  return view;
+}
+
+InstanceData BinaryInstances::load(std::size_t i) const {
+  std::vector<partition::ValueType> buffer;
+  return view(i, buffer).toOwned();
+}
+
+BinaryInstanceWriter::BinaryInstanceWriter(const std::string &filePath)
+    : out_(filePath, std::ios::binary | std::ios::trunc), path_(filePath) {
+  if (!out_.is_open()) {
+    throw std::runtime_error("Could not create file: " + filePath);
+  }
+  // The header is rewritten by finish() once the table is known
+  char header[BINARY_HEADER_SIZE] = {};
+  out_.write(header, sizeof(header));
+  position_ = sizeof(header);
+}
+
+BinaryInstanceWriter::~BinaryInstanceWriter() {
+  if (!finished_) {
+    try {
+      finish();
+    } catch (const std::exception &e) {
+      std::cerr << "[ERROR] " << e.what() << std::endl;
+    }
+  }
+}
+
+void BinaryInstanceWriter::add(const InstanceView &instance) {
+  std::size_t width = valueWidth(instance.values);
+  offsets_.push_back(position_);
+  optimalSums_.push_back(instance.optimalSum);
+  M_.push_back(static_cast<std::uint32_t>(instance.values.size));
+  N_.push_back(static_cast<std::uint32_t>(instance.N));
+  B_.push_back(static_cast<std::uint32_t>(instance.B));
+  widths_.push_back(static_cast<std::uint8_t>(width));
+
+  // Padded so that every block starts 8-byte aligned
+  std::uint64_t size = instance.values.size * width;
+  bytes_.assign(padTo8(size), 0);
+  for (std::size_t k = 0; k < instance.values.size; k++) {
+    putLE(bytes_.data() + k * width, instance.values[k], width);
+  }
+  out_.write(reinterpret_cast<const char *>(bytes_.data()), bytes_.size());
+  position_ += bytes_.size();
+}
+
+void BinaryInstanceWriter::add(const InstanceData &instance) {
+  add(InstanceView{instance.M, instance.N, instance.B, instance.optimalSum,
+                   ValueSpan{instance.values.data(), instance.values.size()}});
+}
+
+void BinaryInstanceWriter::finish() {
+  finished_ = true;
+
+  bytes_.clear();
+  for (std::uint64_t offset : offsets_) {
+    appendLE(bytes_, offset);
+  }
+  for (std::uint64_t optimalSum : optimalSums_) {
+    appendLE(bytes_, optimalSum);
+  }
+  for (const auto *column : {&M_, &N_, &B_}) {
+    for (std::uint32_t value : *column) {
+      appendLE(bytes_, value);
     }
   }
+  bytes_.insert(bytes_.end(), widths_.begin(), widths_.end());
+  out_.write(reinterpret_cast<const char *>(bytes_.data()), bytes_.size());
+
+  unsigned char header[BINARY_HEADER_SIZE] = {};
+  std::memcpy(header, BINARY_MAGIC, sizeof(BINARY_MAGIC));
+  putLE(header + 8, BINARY_VERSION, 4);
+  putLE(header + 16, offsets_.size(), 8);
+  putLE(header + 24, position_, 8);
+  out_.seekp(0);
+  out_.write(reinterpret_cast<const char *>(header), sizeof(header));
+
+  out_.close();
+  if (out_.fail()) {
+    throw std::runtime_error("Could not write file: " + path_);
+  }
+}
+
+bool isBinaryInstanceFile(const std::string &filePath) {
+  std::ifstream file(filePath, std::ios::binary);
+  char magic[sizeof(BINARY_MAGIC)] = {};
+  return file.read(magic, sizeof(magic)) &&
+         std::memcmp(magic, BINARY_MAGIC, sizeof(magic)) == 0;
+}
 
-  // Don't forget to add the last instance if file ends without another header
-  if (readingValues && valuesCount == current.M) {
-    instances.push_back(current);
-  } else if (readingValues) {
-    std::cerr << "[ERRO] Instância incompleta ignorada.\n";
+void writeTextInstance(std::ostream &out, std::size_t id,
+                       const InstanceView &instance) {
+  out << "# Instance " << id << "\n";
+  out << instance.M << " " << instance.N << " " << instance.B << " "
+      << instance.optimalSum << "\n";
+  for (std::size_t i = 0; i < instance.values.size; i++) {
+    out << instance.values[i] << (i + 1 < instance.values.size ? " " : "\n");
   }
+  out << "\n";
+}
 
-  file.close();
+std::vector<InstanceData> readInstances(const std::string &filePath) {
+  std::vector<InstanceData> instances;
+  try {
+    if (isBinaryInstanceFile(filePath)) {
+      BinaryInstances binary(filePath);
+      instances.reserve(binary.size());
+      for (std::size_t i = 0; i < binary.size(); i++) {
+        instances.push_back(binary.load(i));
+      }
+      return instances;
+    }
+    for (const InstanceView &instance : InstanceStream(filePath)) {
+      instances.push_back(instance.toOwned());
+    }
+  } catch (const std::runtime_error &e) {
+    std::cerr << "[ERROR] " << e.what() << std::endl;
+  }
   return instances;
 }
 
@@ -1,6 +1,10 @@
 #ifndef READINSTANCES_HPP
 #define READINSTANCES_HPP
 
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <ostream>
 #include <vector>
 #include <string>
 #include "Partition.hpp"
@@ -20,6 +24,258 @@ struct InstanceData {
     std::vector<partition::ValueType> values; // List of generated numbers
 };
 
+/**
+ * @brief Read-only view of contiguous values.
+ */
+struct ValueSpan {
+    const partition::ValueType *data = nullptr;
+    std::size_t size = 0;
+
+    const partition::ValueType *begin() const { return data; }
+    const partition::ValueType *end() const { return data + size; }
+    partition::ValueType operator[](std::size_t i) const { return data[i]; }
+};
+
+/**
+ * @brief One instance as seen while iterating a file, without copying it.
+ *
+ * The values stay valid until the iterator that produced the view advances.
+ */
+struct InstanceView {
+    int M;
+    int N;
+    int B;
+    partition::ValueType optimalSum;
+    ValueSpan values;
+
+    /**
+     * @brief Copies the instance into out, reusing its buffers.
+     */
+    void copyTo(InstanceData &out) const;
+
+    /**
+     * @brief Returns an owning copy of the instance.
+     */
+    InstanceData toOwned() const;
+};
+
+/**
+ * @brief Read-only memory mapping of a whole file (read into memory where
+ * mmap is not available).
+ */
+class MappedFile {
+public:
+    /**
+     * @brief Maps the file.
+     *
+     * @param filePath Path to the file.
+     * @param sequential Whether the file is read front to back (otherwise
+     * accesses are random).
+     * @throws std::runtime_error If the file cannot be opened or mapped.
+     */
+    explicit MappedFile(const std::string &filePath, bool sequential = true);
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    const char *data() const { return data_; }
+    std::size_t size() const { return size_; }
+
+private:
+    const char *data_ = nullptr;
+    std::size_t size_ = 0;
+    std::string fallback_; // contents when the file is not mapped
+};
+
+/**
+ * @brief Lazy range over the instances of a text file.
+ *
+ * The file is memory-mapped and every instance is parsed with
+ * std::from_chars only when the iteration reaches it, so the first instance
+ * is available at once and memory holds a single instance at a time.
+ * Malformed instances are reported on stderr and skipped.
+ *
+ * Usage: for (const InstanceView &instance : InstanceStream(path)) { ... }
+ */
+class InstanceStream {
+public:
+    /**
+     * @brief Input iterator over the instances; dereferences to the current
+     * instance.
+     */
+    class iterator {
+    public:
+        const InstanceView &operator*() const { return current(); }
+        const InstanceView *operator->() const { return &current(); }
+        iterator &operator++();
+        bool operator==(const iterator &other) const {
+            return at_ == other.at_;
+        }
+        bool operator!=(const iterator &other) const {
+            return !(*this == other);
+        }
+
+        /**
+         * @brief Returns how many bytes of the file were consumed so far.
+         */
+        std::size_t offset() const;
+
+    private:
+        friend class InstanceStream;
+        iterator(const InstanceStream *stream, const char *at);
+
+        // The view with its values pointed at this copy's buffer
+        const InstanceView &current() const {
+            view_.values = ValueSpan{values_.data(), values_.size()};
+            return view_;
+        }
+
+        const InstanceStream *stream_ = nullptr;
+        const char *at_ = nullptr;   // start of the current instance
+        const char *next_ = nullptr; // where the next instance is looked for
+        mutable InstanceView view_{};
+        std::vector<partition::ValueType> values_;
+    };
+
+    /**
+     * @brief Maps the file for iteration.
+     *
+     * @param filePath Path to the instance file.
+     * @throws std::runtime_error If the file cannot be opened.
+     */
+    explicit InstanceStream(const std::string &filePath);
+
+    iterator begin() const;
+    iterator end() const;
+
+    /**
+     * @brief Returns the size of the file in bytes.
+     */
+    std::size_t size() const { return file_.size(); }
+
+private:
+    MappedFile file_;
+};
+
+/**
+ * @brief Random-access reader of the binary instance format.
+ *
+ * Layout (every integer little-endian, every block 8-byte aligned):
+ *   header:  "NPARTBIN" | uint32 version | uint32 0 | uint64 count
+ *            | uint64 table offset
+ *   values:  one block per instance, M values of width[i] bytes each
+ *   table:   uint64 offset[count] | uint64 optimalSum[count]
+ *            | uint32 M[count] | uint32 N[count] | uint32 B[count]
+ *            | uint8 width[count]
+ *
+ * The width is the smallest of 1, 2, 4 or 8 bytes that holds every value of
+ * the instance, so values drawn with B bits take about B/8 bytes each.
+ * Full-width values are viewed straight from the mapping on little-endian
+ * hosts; narrower ones are widened into the caller's buffer.
+ */
+class BinaryInstances {
+public:
+    /**
+     * @brief Maps the file and checks its header and table.
+     *
+     * @param filePath Path to the binary instance file.
+     * @throws std::runtime_error If the file cannot be opened or is not a
+     * valid binary instance file.
+     */
+    explicit BinaryInstances(const std::string &filePath);
+
+    /**
+     * @brief Returns the number of instances in the file.
+     */
+    std::size_t size() const { return count_; }
+
+    /**
+     * @brief Returns instance i without parsing the ones before it.
+     *
+     * @param i Index of the instance, in [0, size()).
+     * @param buffer Storage for the values when they cannot be viewed in
+     * place; the view is valid while buffer and this reader are.
+     * @throws std::out_of_range If i is not below size().
+     * @throws std::runtime_error If the instance lies outside the file.
+     */
+    InstanceView view(std::size_t i,
+                      std::vector<partition::ValueType> &buffer) const;
+
+    /**
+     * @brief Returns an owning copy of instance i.
+     */
+    InstanceData load(std::size_t i) const;
+
+private:
+    MappedFile file_;
+    std::size_t count_ = 0;
+    const unsigned char *table_ = nullptr;
+};
+
+/**
+ * @brief Sequential writer of the binary instance format.
+ *
+ * Values are written as instances are added and the table is appended by
+ * finish(), so instances never have to be held in memory together.
+ */
+class BinaryInstanceWriter {
+public:
+    /**
+     * @brief Creates (or truncates) the output file.
+     *
+     * @throws std::runtime_error If the file cannot be created.
+     */
+    explicit BinaryInstanceWriter(const std::string &filePath);
+
+    /**
+     * @brief Finishes the file if finish() was not called.
+     */
+    ~BinaryInstanceWriter();
+
+    BinaryInstanceWriter(const BinaryInstanceWriter &) = delete;
+    BinaryInstanceWriter &operator=(const BinaryInstanceWriter &) = delete;
+
+    /**
+     * @brief Appends one instance.
+     */
+    void add(const InstanceView &instance);
+    void add(const InstanceData &instance);
+
+    /**
+     * @brief Writes the table and the header.
+     *
+     * @throws std::runtime_error If writing fails.
+     */
+    void finish();
+
+private:
+    std::ofstream out_;
+    std::string path_;
+    std::uint64_t position_ = 0;
+    std::vector<std::uint64_t> offsets_;
+    std::vector<std::uint64_t> optimalSums_;
+    std::vector<std::uint32_t> M_, N_, B_;
+    std::vector<std::uint8_t> widths_;
+    std::vector<unsigned char> bytes_; // encoding buffer
+    bool finished_ = false;
+};
+
+/**
+ * @brief Tells whether the file starts with the binary format's magic.
+ */
+bool isBinaryInstanceFile(const std::string &filePath);
+
+/**
+ * @brief Writes one instance in the text format.
+ *
+ * @param out Output stream.
+ * @param id Number printed on the "# Instance" line.
+ * @param instance Instance to write.
+ */
+void writeTextInstance(std::ostream &out, std::size_t id,
+                       const InstanceView &instance);
+
 /**
  * @brief Reads all instances from the specified file.
  * 
@@ -27,6 +283,9 @@ struct InstanceData {
  *   # Instance X
  *   N K B OPTIMAL_SUM
  *   num1 num2 num3 ...
+ *
+ * Files in the binary format (see BinaryInstances) are recognized by their
+ * magic and read as well.
  * 
  * @param filePath Path to the instance file.
  * @return std::vector<InstanceData> A vector containing all instances.
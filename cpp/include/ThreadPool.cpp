@@ -0,0 +1,234 @@
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <iterator>
+
+namespace partition {
+
+namespace {
+// Pool and queue of the worker running on this thread, if any.
+thread_local const ThreadPool *currentPool = nullptr;
+thread_local std::size_t currentIndex = 0;
+} // namespace
+
+ThreadPool::ThreadPool(std::size_t threads) {
+  if (threads == 0) {
+    threads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+  }
+
+  // One queue per worker plus the shared one
+  for (std::size_t i = 0; i <= threads; i++) {
+    queues_.push_back(std::make_unique<Queue>());
+  }
+
+  workers_.reserve(threads);
+  for (std::size_t i = 0; i < threads; i++) {
+    workers_.emplace_back([this, i] { workerLoop(i); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  ready_.notify_all();
+
+  for (auto &worker : workers_) {
+    worker.join();
+  }
+}
+
+void ThreadPool::parallelFor(std::size_t count,
+                             const std::function<void(std::size_t)> &body) {
+  if (count == 0) {
+    return;
+  }
+
+  // Helpers that start after every index was claimed return without touching
+  // the body, so only the shared counters must outlive this call.
+  struct State {
+    std::atomic<std::size_t> next{0};
+    std::atomic<std::size_t> done{0};
+    std::size_t count = 0;
+    const std::function<void(std::size_t)> *body = nullptr;
+    std::mutex mutex;
+    std::condition_variable finished;
+    std::exception_ptr error;
+  };
+
+  auto state = std::make_shared<State>();
+  state->count = count;
+  state->body = &body;
+
+  auto run = [state] {
+    std::size_t i;
+    while ((i = state->next++) < state->count) {
+      try {
+        (*state->body)(i);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (!state->error) {
+          state->error = std::current_exception();
+        }
+      }
+
+      if (++state->done == state->count) {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->finished.notify_all();
+      }
+    }
+  };
+
+  std::size_t helpers = std::min(size(), count - 1);
+  for (std::size_t h = 0; h < helpers; h++) {
+    enqueue(run);
+  }
+  run();
+
+  std::unique_lock<std::mutex> lock(state->mutex);
+  state->finished.wait(lock, [&] { return state->done == state->count; });
+  if (state->error) {
+    std::rethrow_exception(state->error);
+  }
+}
+
+ThreadPool &ThreadPool::shared() {
+  static ThreadPool pool;
+  return pool;
+}
+
+std::size_t ThreadPool::currentQueue() const {
+  return currentPool == this ? currentIndex : size();
+}
+
+void ThreadPool::enqueue(std::function<void()> task, TaskGroup *group) {
+  Queue &queue = *queues_[currentQueue()];
+  {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.tasks.push_back({std::move(task), group});
+    pending_++;
+    if (group != nullptr) {
+      group->queued_++;
+    }
+  }
+
+  // Taking the lock orders the increment before a sleeper's last check. All
+  // sleepers are woken since some of them may be waiting for a group instead
+  wakeAll();
+}
+
+bool ThreadPool::runOne(std::size_t self, const TaskGroup *only) {
+  Task task{nullptr, nullptr};
+  auto eligible = [only](const Task &t) {
+    return only == nullptr || t.group == only;
+  };
+
+  // Own deque first (newest task), then steal the oldest task of the next
+  // queues. Threads outside the pool own the shared queue. With only set,
+  // tasks of other groups are skipped
+  const std::size_t count = queues_.size();
+  for (std::size_t k = 0; k < count && !task.run; k++) {
+    std::size_t index = (self + k) % count;
+    Queue &queue = *queues_[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    auto &tasks = queue.tasks;
+    auto it = tasks.end();
+    if (k == 0) {
+      auto r = std::find_if(tasks.rbegin(), tasks.rend(), eligible);
+      if (r != tasks.rend()) {
+        it = std::prev(r.base());
+      }
+    } else {
+      it = std::find_if(tasks.begin(), tasks.end(), eligible);
+    }
+    if (it == tasks.end()) {
+      continue;
+    }
+    task = std::move(*it);
+    tasks.erase(it);
+    pending_--;
+    if (task.group != nullptr) {
+      task.group->queued_--;
+    }
+  }
+
+  if (!task.run) {
+    return false;
+  }
+  task.run();
+  return true;
+}
+
+void ThreadPool::helpUntil(TaskGroup &group) {
+  const std::size_t self = currentQueue();
+  while (group.outstanding_ != 0) {
+    if (runOne(self, &group)) {
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    ready_.wait(lock, [&] {
+      return group.outstanding_ == 0 || group.queued_ > 0;
+    });
+  }
+}
+
+void ThreadPool::wakeAll() {
+  { std::lock_guard<std::mutex> lock(mutex_); }
+  ready_.notify_all();
+}
+
+void ThreadPool::workerLoop(std::size_t index) {
+  currentPool = this;
+  currentIndex = index;
+
+  while (true) {
+    if (runOne(index)) {
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    ready_.wait(lock, [this] { return stopping_ || pending_ > 0; });
+    if (stopping_ && pending_ == 0) {
+      return;
+    }
+  }
+}
+
+TaskGroup::~TaskGroup() { pool_.helpUntil(*this); }
+
+void TaskGroup::run(std::function<void()> task) {
+  outstanding_++;
+
+  // The group may be gone once the count drops to zero, so the wakeup must
+  // not go through this
+  ThreadPool *pool = &pool_;
+  pool_.enqueue(
+      [this, pool, task = std::move(task)] {
+        try {
+          task();
+        } catch (...) {
+          std::lock_guard<std::mutex> lock(mutex_);
+          if (!error_) {
+            error_ = std::current_exception();
+          }
+        }
+
+        if (--outstanding_ == 0) {
+          pool->wakeAll();
+        }
+      },
+      this);
+}
+
+void TaskGroup::wait() {
+  pool_.helpUntil(*this);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (error_) {
+    std::exception_ptr error = error_;
+    error_ = nullptr;
+    std::rethrow_exception(error);
+  }
+}
+} // namespace partition
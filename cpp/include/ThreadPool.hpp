@@ -0,0 +1,155 @@
+#ifndef THREADPOOL_HPP
+#define THREADPOOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace partition {
+
+class TaskGroup;
+
+/**
+ * @brief Fixed-size work-stealing pool of worker threads shared by the
+ * parallel solvers.
+ *
+ * Every worker owns a deque: tasks queued from inside a task go to the back of
+ * the deque of the worker running it and are taken back LIFO, while idle
+ * workers steal from the front of the others. Tasks queued from outside the
+ * pool go to a shared queue.
+ */
+class ThreadPool {
+public:
+  /**
+   * @brief Starts the worker threads.
+   *
+   * @param threads The number of workers (0 uses the hardware concurrency).
+   */
+  explicit ThreadPool(std::size_t threads = 0);
+
+  /**
+   * @brief Finishes the queued tasks and joins the workers.
+   */
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  /**
+   * @brief Returns the number of worker threads.
+   */
+  std::size_t size() const { return workers_.size(); }
+
+  /**
+   * @brief Queues a task for execution on a worker.
+   *
+   * @param task The callable to run.
+   * @return A future with the result of the task.
+   */
+  template <typename F>
+  std::future<std::invoke_result_t<F>> submit(F &&task);
+
+  /**
+   * @brief Runs body(i) for every i in [0, count) and waits for all of them.
+   *
+   * The calling thread takes part in the work, so calling it from inside a
+   * task of the same pool cannot deadlock. The first exception thrown by the
+   * body is rethrown here.
+   *
+   * @param count The number of indices.
+   * @param body The callable invoked once per index.
+   */
+  void parallelFor(std::size_t count,
+                   const std::function<void(std::size_t)> &body);
+
+  /**
+   * @brief Returns the process-wide pool, sized to the hardware concurrency.
+   */
+  static ThreadPool &shared();
+
+private:
+  friend class TaskGroup;
+
+  // Queued task, with the group it belongs to (null outside groups).
+  struct Task {
+    std::function<void()> run;
+    TaskGroup *group;
+  };
+
+  // Task queue of one worker, or the shared queue (last slot).
+  struct Queue {
+    std::deque<Task> tasks;
+    std::mutex mutex;
+  };
+
+  void enqueue(std::function<void()> task, TaskGroup *group = nullptr);
+  bool runOne(std::size_t self, const TaskGroup *only = nullptr);
+  void helpUntil(TaskGroup &group);
+  void wakeAll();
+  void workerLoop(std::size_t index);
+  std::size_t currentQueue() const;
+
+  std::vector<std::unique_ptr<Queue>> queues_;
+  std::vector<std::thread> workers_;
+  std::atomic<std::size_t> pending_{0};
+  std::mutex mutex_;
+  std::condition_variable ready_;
+  bool stopping_ = false;
+};
+
+/**
+ * @brief Set of tasks on a pool that can spawn more tasks and be waited for
+ * as a whole.
+ */
+class TaskGroup {
+public:
+  explicit TaskGroup(ThreadPool &pool) : pool_(pool) {}
+
+  /**
+   * @brief Waits for the tasks still running.
+   */
+  ~TaskGroup();
+
+  TaskGroup(const TaskGroup &) = delete;
+  TaskGroup &operator=(const TaskGroup &) = delete;
+
+  /**
+   * @brief Queues a task of the group. May be called from inside its tasks.
+   *
+   * @param task The callable to run.
+   */
+  void run(std::function<void()> task);
+
+  /**
+   * @brief Runs queued tasks of the group on the calling thread until every
+   * task of the group finished. The first exception thrown by a task is
+   * rethrown here.
+   *
+   * Tasks of other groups are left to the workers, so a waiting caller never
+   * runs unrelated work on top of its own thread-local state.
+   */
+  void wait();
+
+private:
+  friend class ThreadPool;
+
+  ThreadPool &pool_;
+  std::atomic<std::size_t> outstanding_{0};
+  std::atomic<std::size_t> queued_{0}; // tasks not yet taken by a thread
+  std::mutex mutex_;
+  std::exception_ptr error_;
+};
+} // namespace partition
+
+#include "ThreadPool.tpp"
+
+#endif // THREADPOOL_HPP
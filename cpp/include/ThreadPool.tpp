@@ -0,0 +1,18 @@
+#pragma once
+#include <memory>
+#include <utility>
+
+namespace partition {
+
+template <typename F>
+std::future<std::invoke_result_t<F>> ThreadPool::submit(F &&task) {
+  using Result = std::invoke_result_t<F>;
+
+  // std::function needs a copyable target, so the task lives in a shared_ptr
+  auto packaged =
+      std::make_shared<std::packaged_task<Result()>>(std::forward<F>(task));
+  std::future<Result> result = packaged->get_future();
+  enqueue([packaged] { (*packaged)(); });
+  return result;
+}
+} // namespace partition
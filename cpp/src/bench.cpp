@@ -0,0 +1,523 @@
+#include "Partition.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <getopt.h>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace partition;
+
+/**
+ * @brief Micro-benchmark of the partition algorithms.
+ *
+ * Sweeps every (algorithm, strategy, n, m, B) combination. Each case is
+ * warmed up, then timed in samples of a calibrated batch of calls (so that
+ * fast algorithms are not dominated by the clock resolution) until the 95%
+ * confidence interval of the mean is tight enough or a run/time budget is
+ * spent. Results go to CSV or JSON and can be compared against a previous
+ * CSV run to flag regressions.
+ */
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+// Shortest sample; calls are batched until a sample takes at least this long
+const std::chrono::nanoseconds MIN_SAMPLE_TIME = std::chrono::microseconds(20);
+
+struct BenchConfig {
+  std::vector<Solver> algorithms = {Solver::LS, Solver::LPT,
+                                    Solver::KK, Solver::MULTIFIT,
+                                    Solver::SA, Solver::GA};
+  std::vector<std::string> strategies = {"random", "balanced"};
+  std::vector<int> n = {2, 4, 8};
+  std::vector<int> m = {10, 100, 1000};
+  std::vector<int> b = {8, 16, 32};
+  int warmup = 3;             // untimed calls before sampling
+  int minSamples = 10;        // samples before the stop rule is checked
+  int maxSamples = 1000;      // hard cap of samples per case
+  double maxSeconds = 1.0;    // sampling budget per case
+  double targetCi = 0.02;     // stop at a 95% CI half width below this x mean
+  std::uint64_t seed = 1;     // instance generation seed
+  std::string format = "csv"; // csv or json
+  std::string output;         // empty = stdout
+  std::string baseline;       // CSV of a previous run
+  double threshold = 0.10;    // median slowdown flagged as a regression
+};
+
+struct CaseKey {
+  std::string algorithm, strategy;
+  int n, m, b;
+
+  bool operator<(const CaseKey &other) const {
+    return std::tie(algorithm, strategy, n, m, b) <
+           std::tie(other.algorithm, other.strategy, other.n, other.m,
+                    other.b);
+  }
+};
+
+struct CaseResult {
+  CaseKey key;
+  std::size_t samples = 0;
+  std::size_t batch = 0; // calls per sample
+  double minNs = 0, medianNs = 0, p90Ns = 0, p99Ns = 0, maxNs = 0;
+  double meanNs = 0, ciNs = 0; // mean and 95% CI half width, per call
+  double itemsPerSecond = 0;   // m / median
+  ValueType makespan = 0;      // of the last call
+};
+
+const Solver ALL_SOLVERS[] = {Solver::LS,  Solver::LPT, Solver::KK,
+                              Solver::MULTIFIT, Solver::CGA,
+                              Solver::RNP, Solver::DP, Solver::GA,
+                              Solver::GA2, Solver::SA};
+
+void fail(const std::string &message) {
+  std::cerr << "[ERROR] " << message << "\n";
+  std::exit(1);
+}
+
+std::vector<std::string> splitList(const std::string &list) {
+  std::vector<std::string> items;
+  std::stringstream in(list);
+  for (std::string item; std::getline(in, item, ',');) {
+    if (!item.empty()) {
+      items.push_back(item);
+    }
+  }
+  return items;
+}
+
+std::vector<int> parseInts(const std::string &list, const char *option) {
+  std::vector<int> values;
+  for (const std::string &item : splitList(list)) {
+    int value = std::atoi(item.c_str());
+    if (value <= 0) {
+      fail(std::string("Invalid --") + option + " value: " + item);
+    }
+    values.push_back(value);
+  }
+  return values;
+}
+
+Solver parseSolver(const std::string &name) {
+  for (Solver solver : ALL_SOLVERS) {
+    if (name == solverName(solver)) {
+      return solver;
+    }
+  }
+  fail("Unknown algorithm: " + name);
+  return Solver::LS;
+}
+
+// Values with B random bits each.
+std::vector<ValueType> randomInstance(std::mt19937_64 &rng, int m, int b) {
+  std::uniform_int_distribution<ValueType> value(
+      1, b >= 64 ? UINT64_MAX : (ValueType(1) << b) - 1);
+  std::vector<ValueType> values(m);
+  for (ValueType &v : values) {
+    v = value(rng);
+  }
+  return values;
+}
+
+// n groups of equal sum, each split at random, so that a perfect partition
+// exists; the values are then shuffled. Groups sum to 2^(b-1) per item,
+// capped so that the n of them together still fit in a ValueType.
+std::vector<ValueType> balancedInstance(std::mt19937_64 &rng, int n, int m,
+                                        int b) {
+  std::vector<ValueType> values;
+  const ValueType perItem = ValueType(1) << (std::min(b, 64) - 1);
+  const ValueType items = std::max(1, m / n);
+  const ValueType cap = UINT64_MAX / ValueType(n);
+  ValueType groupSum = perItem > cap / items ? cap : perItem * items;
+  for (int g = 0; g < n; g++) {
+    int size = m / n + (g < m % n ? 1 : 0);
+    ValueType remaining = std::max<ValueType>(groupSum, size);
+    for (int i = 0; i + 1 < size; i++) {
+      std::uniform_int_distribution<ValueType> part(
+          1, remaining - (size - i - 1));
+      ValueType v = std::min(part(rng), remaining / 2 + 1);
+      values.push_back(v);
+      remaining -= v;
+    }
+    if (size > 0) {
+      values.push_back(remaining);
+    }
+  }
+  std::shuffle(values.begin(), values.end(), rng);
+  return values;
+}
+
+void runSolver(Solver solver, const std::vector<ValueType> &arr,
+               std::size_t n, Assignment &out) {
+  switch (solver) {
+  case Solver::LS:
+    LS(arr, n, out);
+    break;
+  case Solver::LPT:
+    LPT(arr, n, out);
+    break;
+  case Solver::KK:
+    KK(arr, n, out);
+    break;
+  case Solver::MULTIFIT:
+    MULTIFIT(arr, n, out);
+    break;
+  case Solver::CGA:
+    CGA(arr, n, out);
+    break;
+  case Solver::RNP:
+    RNP(arr, n, out);
+    break;
+  case Solver::DP:
+    solveExact(arr, n, out, ExactSolver::DP);
+    break;
+  case Solver::GA:
+    geneticAlgorithm(arr, n, out);
+    break;
+  case Solver::GA2:
+    geneticAlgorithm2(arr, n, out);
+    break;
+  case Solver::SA:
+    SimulatedAnnealing(arr, n, out);
+    break;
+  }
+}
+
+// Nearest-rank percentile of sorted samples.
+double percentile(const std::vector<double> &sorted, double p) {
+  std::size_t rank = static_cast<std::size_t>(std::ceil(p * sorted.size()));
+  return sorted[std::min(sorted.size() - 1, rank > 0 ? rank - 1 : 0)];
+}
+
+CaseResult measure(const BenchConfig &cfg, Solver solver, const CaseKey &key,
+                   const std::vector<ValueType> &arr) {
+  const std::size_t n = static_cast<std::size_t>(key.n);
+  Assignment out;
+  auto call = [&] { runSolver(solver, arr, n, out); };
+
+  for (int w = 0; w < cfg.warmup; w++) {
+    call();
+  }
+
+  // Batch size: double until one batch lasts MIN_SAMPLE_TIME
+  std::size_t batch = 1;
+  while (true) {
+    auto start = Clock::now();
+    for (std::size_t k = 0; k < batch; k++) {
+      call();
+    }
+    if (Clock::now() - start >= MIN_SAMPLE_TIME || batch >= (1u << 20)) {
+      break;
+    }
+    batch *= 2;
+  }
+
+  std::vector<double> samples; // ns per call
+  double sum = 0, sumSquares = 0, mean = 0, ci = 0;
+  auto deadline =
+      Clock::now() + std::chrono::duration_cast<Clock::duration>(
+                         std::chrono::duration<double>(cfg.maxSeconds));
+  while (true) {
+    auto start = Clock::now();
+    for (std::size_t k = 0; k < batch; k++) {
+      call();
+    }
+    auto end = Clock::now();
+    double ns =
+        std::chrono::duration<double, std::nano>(end - start).count() / batch;
+    samples.push_back(ns);
+    sum += ns;
+    sumSquares += ns * ns;
+
+    const double count = static_cast<double>(samples.size());
+    mean = sum / count;
+    double variance =
+        count > 1 ? std::max(0.0, (sumSquares - count * mean * mean) /
+                                      (count - 1))
+                  : 0.0;
+    ci = 1.96 * std::sqrt(variance / count);
+
+    if (samples.size() >= static_cast<std::size_t>(cfg.maxSamples) ||
+        (samples.size() >= static_cast<std::size_t>(cfg.minSamples) &&
+         (ci <= cfg.targetCi * mean || end >= deadline))) {
+      break;
+    }
+  }
+
+  std::sort(samples.begin(), samples.end());
+  CaseResult result;
+  result.key = key;
+  result.samples = samples.size();
+  result.batch = batch;
+  result.minNs = samples.front();
+  result.medianNs = percentile(samples, 0.5);
+  result.p90Ns = percentile(samples, 0.9);
+  result.p99Ns = percentile(samples, 0.99);
+  result.maxNs = samples.back();
+  result.meanNs = mean;
+  result.ciNs = ci;
+  result.itemsPerSecond = result.medianNs > 0 ? key.m * 1e9 / result.medianNs
+                                              : 0.0;
+  result.makespan = out.makespan;
+  return result;
+}
+
+const char *CSV_HEADER =
+    "algorithm,strategy,n,m,B,samples,batch,min_ns,median_ns,p90_ns,p99_ns,"
+    "max_ns,mean_ns,ci95_ns,items_per_s,makespan";
+
+void writeCsv(std::ostream &os, const std::vector<CaseResult> &results) {
+  os << CSV_HEADER << "\n" << std::fixed << std::setprecision(1);
+  for (const CaseResult &r : results) {
+    os << r.key.algorithm << "," << r.key.strategy << "," << r.key.n << ","
+       << r.key.m << "," << r.key.b << "," << r.samples << "," << r.batch
+       << "," << r.minNs << "," << r.medianNs << "," << r.p90Ns << ","
+       << r.p99Ns << "," << r.maxNs << "," << r.meanNs << "," << r.ciNs
+       << "," << r.itemsPerSecond << "," << r.makespan << "\n";
+  }
+}
+
+void writeJson(std::ostream &os, const std::vector<CaseResult> &results) {
+  os << "{\n  \"benchmarks\": [" << std::fixed << std::setprecision(1);
+  for (std::size_t i = 0; i < results.size(); i++) {
+    const CaseResult &r = results[i];
+    os << (i ? "," : "") << "\n    {\"algorithm\": \"" << r.key.algorithm
+       << "\", \"strategy\": \"" << r.key.strategy << "\", \"n\": " << r.key.n
+       << ", \"m\": " << r.key.m << ", \"B\": " << r.key.b
+       << ", \"samples\": " << r.samples << ", \"batch\": " << r.batch
+       << ", \"min_ns\": " << r.minNs << ", \"median_ns\": " << r.medianNs
+       << ", \"p90_ns\": " << r.p90Ns << ", \"p99_ns\": " << r.p99Ns
+       << ", \"max_ns\": " << r.maxNs << ", \"mean_ns\": " << r.meanNs
+       << ", \"ci95_ns\": " << r.ciNs
+       << ", \"items_per_s\": " << r.itemsPerSecond
+       << ", \"makespan\": " << r.makespan << "}";
+  }
+  os << "\n  ]\n}\n";
+}
+
+// Median per case of a CSV written by this program.
+std::map<CaseKey, double> readBaseline(const std::string &path) {
+  std::ifstream in(path);
+  if (!in.is_open()) {
+    fail("Could not open baseline: " + path);
+  }
+  std::map<CaseKey, double> medians;
+  std::string line;
+  std::getline(in, line);
+  if (line != CSV_HEADER) {
+    fail("Baseline is not a CSV written by n-partition-bench: " + path);
+  }
+  while (std::getline(in, line)) {
+    std::vector<std::string> fields;
+    std::stringstream row(line);
+    for (std::string field; std::getline(row, field, ',');) {
+      fields.push_back(field);
+    }
+    if (fields.size() < 9) {
+      continue;
+    }
+    CaseKey key{fields[0], fields[1], std::atoi(fields[2].c_str()),
+                std::atoi(fields[3].c_str()), std::atoi(fields[4].c_str())};
+    medians[key] = std::atof(fields[8].c_str());
+  }
+  return medians;
+}
+
+// Prints every case slower than the baseline by more than the threshold and
+// returns how many there were.
+std::size_t compareBaseline(const BenchConfig &cfg,
+                            const std::vector<CaseResult> &results) {
+  std::map<CaseKey, double> baseline = readBaseline(cfg.baseline);
+  std::size_t regressions = 0, compared = 0;
+  std::cerr << std::fixed << std::setprecision(1);
+  for (const CaseResult &r : results) {
+    auto it = baseline.find(r.key);
+    if (it == baseline.end() || it->second <= 0) {
+      continue;
+    }
+    compared++;
+    double change = r.medianNs / it->second - 1.0;
+    if (change > cfg.threshold) {
+      regressions++;
+      std::cerr << "[REGRESSION] " << r.key.algorithm << " "
+                << r.key.strategy << " n=" << r.key.n << " m=" << r.key.m
+                << " B=" << r.key.b << ": " << it->second << " ns -> "
+                << r.medianNs << " ns (+" << 100 * change << "%)\n";
+    }
+  }
+  std::cerr << "Compared " << compared << " case(s) with the baseline, "
+            << regressions << " regression(s) above "
+            << 100 * cfg.threshold << "%\n";
+  return regressions;
+}
+
+void usage(const char *program) {
+  std::cerr
+      << "Usage: " << program << " [options]\n"
+      << "  --algorithms LIST  LS,LPT,KK,MULTIFIT,CGA,RNP,DP,Genetic,"
+         "Genetic2,SA\n"
+      << "  --strategies LIST  random,balanced\n"
+      << "  --n LIST --m LIST --b LIST   sweep values\n"
+      << "  --warmup K  --min-samples K  --max-samples K\n"
+      << "  --max-time S       sampling budget per case, in seconds\n"
+      << "  --ci X             target 95% CI half width, relative to the "
+         "mean\n"
+      << "  --seed S  --format csv|json  --output FILE\n"
+      << "  --baseline FILE    previous CSV; slower medians are flagged\n"
+      << "  --threshold X      relative slowdown flagged (default 0.10)\n";
+  std::exit(1);
+}
+
+BenchConfig parseCli(int argc, char **argv) {
+  BenchConfig cfg;
+  const struct option options[] = {{"algorithms", required_argument, 0, 'a'},
+                                   {"strategies", required_argument, 0, 's'},
+                                   {"n", required_argument, 0, 'n'},
+                                   {"m", required_argument, 0, 'm'},
+                                   {"b", required_argument, 0, 'b'},
+                                   {"warmup", required_argument, 0, 'w'},
+                                   {"min-samples", required_argument, 0, 'k'},
+                                   {"max-samples", required_argument, 0, 'K'},
+                                   {"max-time", required_argument, 0, 't'},
+                                   {"ci", required_argument, 0, 'c'},
+                                   {"seed", required_argument, 0, 'r'},
+                                   {"format", required_argument, 0, 'f'},
+                                   {"output", required_argument, 0, 'o'},
+                                   {"baseline", required_argument, 0, 'B'},
+                                   {"threshold", required_argument, 0, 'T'},
+                                   {"help", no_argument, 0, 'h'},
+                                   {0, 0, 0, 0}};
+
+  int opt;
+  while ((opt = getopt_long(argc, argv, "", options, nullptr)) != -1) {
+    switch (opt) {
+    case 'a':
+      cfg.algorithms.clear();
+      for (const std::string &name : splitList(optarg)) {
+        cfg.algorithms.push_back(parseSolver(name));
+      }
+      break;
+    case 's':
+      cfg.strategies = splitList(optarg);
+      for (const std::string &strategy : cfg.strategies) {
+        if (strategy != "random" && strategy != "balanced") {
+          fail("Unknown strategy: " + strategy);
+        }
+      }
+      break;
+    case 'n':
+      cfg.n = parseInts(optarg, "n");
+      break;
+    case 'm':
+      cfg.m = parseInts(optarg, "m");
+      break;
+    case 'b':
+      cfg.b = parseInts(optarg, "b");
+      for (int b : cfg.b) {
+        if (b > 64) {
+          fail("Invalid --b value: " + std::to_string(b));
+        }
+      }
+      break;
+    case 'w':
+      cfg.warmup = std::max(0, std::atoi(optarg));
+      break;
+    case 'k':
+      cfg.minSamples = std::max(2, std::atoi(optarg));
+      break;
+    case 'K':
+      cfg.maxSamples = std::max(1, std::atoi(optarg));
+      break;
+    case 't':
+      cfg.maxSeconds = std::atof(optarg);
+      break;
+    case 'c':
+      cfg.targetCi = std::atof(optarg);
+      break;
+    case 'r':
+      cfg.seed = std::strtoull(optarg, nullptr, 0);
+      break;
+    case 'f':
+      cfg.format = optarg;
+      if (cfg.format != "csv" && cfg.format != "json") {
+        fail("Unknown format: " + cfg.format);
+      }
+      break;
+    case 'o':
+      cfg.output = optarg;
+      break;
+    case 'B':
+      cfg.baseline = optarg;
+      break;
+    case 'T':
+      cfg.threshold = std::atof(optarg);
+      break;
+    default:
+      usage(argv[0]);
+    }
+  }
+  cfg.maxSamples = std::max(cfg.maxSamples, cfg.minSamples);
+  return cfg;
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  BenchConfig cfg = parseCli(argc, argv);
+  std::cerr << std::fixed << std::setprecision(1);
+
+  std::vector<CaseResult> results;
+  for (const std::string &strategy : cfg.strategies) {
+    for (int n : cfg.n) {
+      for (int m : cfg.m) {
+        for (int b : cfg.b) {
+          // Every algorithm of a case sees the same instance
+          std::mt19937_64 rng(cfg.seed ^ (std::uint64_t(n) << 48) ^
+                              (std::uint64_t(m) << 16) ^ std::uint64_t(b) ^
+                              (strategy == "random" ? 0 : 1ULL << 63));
+          std::vector<ValueType> arr = strategy == "random"
+                                           ? randomInstance(rng, m, b)
+                                           : balancedInstance(rng, n, m, b);
+
+          for (Solver solver : cfg.algorithms) {
+            CaseKey key{solverName(solver), strategy, n, m, b};
+            results.push_back(measure(cfg, solver, key, arr));
+            const CaseResult &r = results.back();
+            std::cerr << key.algorithm << " " << strategy << " n=" << n
+                      << " m=" << m << " B=" << b << ": median "
+                      << r.medianNs << " ns (" << r.samples << " x "
+                      << r.batch << ")\n";
+          }
+        }
+      }
+    }
+  }
+
+  std::ofstream file;
+  if (!cfg.output.empty()) {
+    file.open(cfg.output);
+    if (!file.is_open()) {
+      fail("Could not open output: " + cfg.output);
+    }
+  }
+  std::ostream &os = cfg.output.empty() ? std::cout : file;
+  if (cfg.format == "json") {
+    writeJson(os, results);
+  } else {
+    writeCsv(os, results);
+  }
+
+  if (!cfg.baseline.empty() && compareBaseline(cfg, results) > 0) {
+    return 2;
+  }
+  return 0;
+}
@@ -0,0 +1,53 @@
+#include "ReadInstances.hpp"
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace ReadInstances;
+
+// Converte entre o formato texto e o formato binário de instâncias. A direção
+// é decidida pelo arquivo de entrada: texto vira binário e vice-versa.
+int main(int argc, char **argv) {
+  if (argc != 3) {
+    std::cerr << "Usage: " << argv[0] << " <input> <output>\n"
+              << "  Text input is written as binary, binary input as text.\n";
+    return EXIT_FAILURE;
+  }
+  const std::string inPath = argv[1];
+  const std::string outPath = argv[2];
+
+  try {
+    std::size_t count = 0;
+    if (isBinaryInstanceFile(inPath)) {
+      BinaryInstances instances(inPath);
+      std::ofstream out(outPath);
+      if (!out.is_open()) {
+        throw std::runtime_error("Could not create file: " + outPath);
+      }
+      std::vector<partition::ValueType> buffer;
+      for (; count < instances.size(); count++) {
+        writeTextInstance(out, count + 1, instances.view(count, buffer));
+      }
+      if (!out.flush()) {
+        throw std::runtime_error("Could not write file: " + outPath);
+      }
+      std::cout << "Binary -> text: ";
+    } else {
+      BinaryInstanceWriter out(outPath);
+      for (const InstanceView &instance : InstanceStream(inPath)) {
+        out.add(instance);
+        count++;
+      }
+      out.finish();
+      std::cout << "Text -> binary: ";
+    }
+    std::cout << count << " instances written to " << outPath << "\n";
+  } catch (const std::exception &e) {
+    std::cerr << "[ERROR] " << e.what() << "\n";
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -1,48 +1,57 @@
 #include "Partition.hpp"
+#include "ThreadPool.hpp"
 #include <bits/stdc++.h>
 #include <getopt.h>
 
 using namespace std;
 using namespace partition; // ValueType vem daqui
 
-static std::mt19937_64 rng((std::random_device())());
+// Gerador baseado em contador (SplitMix64): a saída k é uma mistura de
+// (chave + k * gamma), então cada instância tem seu próprio fluxo, derivado
+// da semente mestre e do id, e o arquivo gerado não depende da ordem em que
+// as threads processam as instâncias.
+struct InstanceRng {
+  using result_type = uint64_t;
 
-ValueType sum_vector(const vector<ValueType> &v) {
-  ValueType s = 0;
-  for (auto x : v)
-    s += x;
-  return s;
-}
+  InstanceRng(uint64_t seed, uint64_t instance_id)
+      : key(mix(seed ^ mix(instance_id + 0x9e3779b97f4a7c15ULL))) {}
+
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() { return UINT64_MAX; }
 
-template <size_t N>
-ValueType compute_makespan_array(const array<vector<ValueType>, N> &groups) {
-  ValueType best = 0;
-  for (const auto &g : groups) {
-    ValueType s = sum_vector(g);
-    if (s > best)
-      best = s;
+  result_type operator()() {
+    return mix(key + (++counter) * 0x9e3779b97f4a7c15ULL);
   }
-  return best;
-}
 
-ValueType call_CGA_and_get_makespan(int n, vector<ValueType> &arr) {
-  switch (n) {
-  case 2:
-    return compute_makespan_array(CGA<2>(arr));
-  case 3:
-    return compute_makespan_array(CGA<3>(arr));
-  case 4:
-    return compute_makespan_array(CGA<4>(arr));
-  case 5:
-    return compute_makespan_array(CGA<5>(arr));
-  case 8:
-    return compute_makespan_array(CGA<8>(arr));
-  default:
-    throw runtime_error("Unsupported n");
+private:
+  static uint64_t mix(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
   }
+
+  uint64_t key;
+  uint64_t counter = 0;
+};
+
+// Solver do ótimo de referência (--exact)
+static ExactSolver exact_solver = ExactSolver::Auto;
+
+// Com várias threads gerando instâncias, cada CGA roda sequencialmente
+static bool exact_parallel = true;
+
+ValueType call_exact_and_get_makespan(int n, const vector<ValueType> &arr) {
+  if (n <= 0)
+    throw runtime_error("Unsupported n");
+  Assignment result;
+  CgaOptions options;
+  options.parallel = exact_parallel;
+  solveExact(arr, static_cast<size_t>(n), result, exact_solver, options);
+  return result.makespan;
 }
 
-pair<ValueType, vector<ValueType>> balanced_strategy(int n, int m, int b) {
+pair<ValueType, vector<ValueType>> balanced_strategy(InstanceRng &rng, int n,
+                                                     int m, int b) {
   // lb pode ficar grande; usamos uint64_t temporário para distribuição
   uint64_t lb = (b >= 64) ? 0 : (1ULL << (b - 1));
   lb = lb * static_cast<uint64_t>(m);
@@ -86,7 +95,8 @@ pair<ValueType, vector<ValueType>> balanced_strategy(int n, int m, int b) {
   return {group_sum, values};
 }
 
-pair<ValueType, vector<ValueType>> random_strategy(int n, int m, int b) {
+pair<ValueType, vector<ValueType>> random_strategy(InstanceRng &rng, int n,
+                                                   int m, int b) {
   uint64_t max_val = (b >= 63) ? UINT64_MAX : ((1ULL << b) - 1ULL);
   std::uniform_int_distribution<uint64_t> dist(1, max_val);
 
@@ -95,8 +105,7 @@ pair<ValueType, vector<ValueType>> random_strategy(int n, int m, int b) {
   for (int i = 0; i < m; i++)
     values.push_back(static_cast<ValueType>(dist(rng)));
 
-  vector<ValueType> tmp = values;
-  ValueType makespan = call_CGA_and_get_makespan(n, tmp);
+  ValueType makespan = call_exact_and_get_makespan(n, values);
 
   return {makespan, values};
 }
@@ -107,6 +116,11 @@ pair<ValueType, vector<ValueType>> random_strategy(int n, int m, int b) {
 struct CLIConfig {
   string outfile = "";
   string strategy = "balanced";
+  ExactSolver exact = ExactSolver::Auto;
+  int max_m = 0; // 0 = limites padrão de max_m_for_n
+  uint64_t seed = 0;
+  bool has_seed = false; // sem --seed, a semente vem de random_device
+  size_t threads = 0;    // 0 = uma thread por núcleo
 };
 
 CLIConfig parse_cli(int argc, char **argv) {
@@ -114,10 +128,14 @@ CLIConfig parse_cli(int argc, char **argv) {
 
   const struct option long_opts[] = {{"file", required_argument, 0, 'f'},
                                      {"strategy", required_argument, 0, 's'},
+                                     {"exact", required_argument, 0, 'e'},
+                                     {"max-m", required_argument, 0, 'm'},
+                                     {"seed", required_argument, 0, 'r'},
+                                     {"threads", required_argument, 0, 't'},
                                      {0, 0, 0, 0}};
 
   while (true) {
-    int opt = getopt_long(argc, argv, "f:s:", long_opts, nullptr);
+    int opt = getopt_long(argc, argv, "f:s:e:m:r:t:", long_opts, nullptr);
     if (opt == -1)
       break;
 
@@ -134,6 +152,48 @@ CLIConfig parse_cli(int argc, char **argv) {
       }
       break;
 
+    case 'e':
+      if (string(optarg) == "auto") {
+        cfg.exact = ExactSolver::Auto;
+      } else if (string(optarg) == "cga") {
+        cfg.exact = ExactSolver::CGA;
+      } else if (string(optarg) == "rnp") {
+        cfg.exact = ExactSolver::RNP;
+      } else if (string(optarg) == "dp") {
+        cfg.exact = ExactSolver::DP;
+      } else {
+        cerr << "Invalid exact solver. Use auto, cga, rnp or dp.\n";
+        exit(1);
+      }
+      break;
+
+    case 'm':
+      cfg.max_m = atoi(optarg);
+      if (cfg.max_m <= 0) {
+        cerr << "Invalid --max-m. Use a positive integer.\n";
+        exit(1);
+      }
+      break;
+
+    case 'r': {
+      char *end = nullptr;
+      cfg.seed = strtoull(optarg, &end, 0);
+      if (*optarg == '\0' || *end != '\0') {
+        cerr << "Invalid --seed. Use a non-negative integer.\n";
+        exit(1);
+      }
+      cfg.has_seed = true;
+      break;
+    }
+
+    case 't':
+      if (atoi(optarg) < 0) {
+        cerr << "Invalid --threads. Use 0 (all cores) or more.\n";
+        exit(1);
+      }
+      cfg.threads = static_cast<size_t>(atoi(optarg));
+      break;
+
     default:
       cerr << "Unknown option\n";
       exit(1);
@@ -182,14 +242,43 @@ int max_m_for_n(int n) {
   }
 }
 
+// Parâmetros de uma instância, na ordem do arquivo
+struct InstanceSpec {
+  int n, m, b;
+};
+
+// Gera a instância id e devolve seu texto já formatado
+string generate_instance(const CLIConfig &cfg, uint64_t seed,
+                         const InstanceSpec &spec, size_t id) {
+  InstanceRng rng(seed, id);
+  pair<ValueType, vector<ValueType>> result =
+      cfg.strategy == "random" ? random_strategy(rng, spec.n, spec.m, spec.b)
+                               : balanced_strategy(rng, spec.n, spec.m, spec.b);
+
+  ValueType makespan = result.first;
+  const vector<ValueType> &values = result.second;
+
+  ostringstream out;
+  out << "# Instance " << id << "\n";
+  out << spec.m << " " << spec.n << " " << spec.b << " " << makespan << "\n";
+  for (size_t i = 0; i < values.size(); ++i)
+    out << values[i] << (i + 1 < values.size() ? " " : "\n");
+  out << "\n";
+  return out.str();
+}
+
 //
 // =================== MAIN ======================
 //
 int main(int argc, char **argv) {
-  // usa parse_cli para --file e --strategy
+  // usa parse_cli para --file, --strategy, --seed e --threads
   CLIConfig cfg = parse_cli(argc, argv);
   string strategy = cfg.strategy;
   string out_filename = cfg.outfile;
+  exact_solver = cfg.exact;
+  uint64_t seed = cfg.has_seed ? cfg.seed
+                               : (uint64_t(random_device()()) << 32) |
+                                     random_device()();
 
   // --- Arquivo ---
   ofstream fout(out_filename);
@@ -198,17 +287,18 @@ int main(int argc, char **argv) {
     return 1;
   }
 
-  // --- Precomputação do total ---
+  // --- Lista de instâncias ---
   vector<int> n_values = {2, 3, 4, 5, 8};
   vector<int> b_values = {4, 8, 16, 32};
   int repetitions = 5;
 
-  size_t total_instances = 0;
+  vector<InstanceSpec> specs;
   for (int n : n_values) {
-    int maxm = max_m_for_n(n);
+    int maxm = cfg.max_m > 0 ? cfg.max_m : max_m_for_n(n);
     for (int m = n; m <= maxm;) {
       for (int b : b_values)
-        total_instances += repetitions;
+        for (int rep = 0; rep < repetitions; ++rep)
+          specs.push_back({n, m, b});
       if (m < 20) {
         m++;
       } else {
@@ -216,54 +306,57 @@ int main(int argc, char **argv) {
       }
     }
   }
+  const size_t total_instances = specs.size();
+
+  size_t threads = cfg.threads > 0
+                       ? cfg.threads
+                       : max<size_t>(1, thread::hardware_concurrency());
+  exact_parallel = threads == 1;
+
+  // --- Geração ---
+  // As instâncias terminam fora de ordem; cada texto espera em pending até
+  // que todas as anteriores tenham sido escritas
+  vector<string> pending(total_instances);
+  vector<char> ready(total_instances, 0);
+  size_t written = 0, prog = 0;
+  mutex out_mutex;
+  auto last_draw = chrono::steady_clock::now();
+
+  auto generate = [&](size_t i) {
+    string text = generate_instance(cfg, seed, specs[i], i + 1);
+
+    lock_guard<mutex> lock(out_mutex);
+    pending[i] = std::move(text);
+    ready[i] = 1;
+    for (; written < total_instances && ready[written]; ++written) {
+      fout << pending[written];
+      string().swap(pending[written]);
+    }
 
-  size_t prog = 0;
-  int instance_id = 1;
-
-  // --- Loop principal ---
-  for (int n : n_values) {
-    int maxm = max_m_for_n(n);
-    for (int m = n; m <= maxm;) {
-      for (int b : b_values) {
-        for (int rep = 0; rep < repetitions; ++rep) {
-          pair<ValueType, vector<ValueType>> result;
-
-          if (strategy == "balanced") {
-            result = balanced_strategy(n, m, b);
-          } else if (strategy == "random") {
-            result = random_strategy(n, m, b);
-          } else {
-            cerr << "Unknown strategy: " << strategy << "\n";
-            return 2;
-          }
-
-          ValueType makespan = result.first;
-          const vector<ValueType> &values = result.second;
-
-          fout << "# Instance " << instance_id << "\n";
-          fout << m << " " << n << " " << b << " " << makespan << "\n";
-          for (size_t i = 0; i < values.size(); ++i)
-            fout << values[i] << (i + 1 < values.size() ? " " : "\n");
-          fout << "\n";
-
-          ++instance_id;
-          ++prog;
-
-          // Mostrar barra de progresso
-          progress_bar(prog, total_instances);
-        }
-      }
-      if (m < 20) {
-        m++;
-      } else {
-        m += 5;
-      }
+    // Mostrar barra de progresso (no máximo a cada 100 ms)
+    ++prog;
+    auto now = chrono::steady_clock::now();
+    if (prog == total_instances ||
+        now - last_draw >= chrono::milliseconds(100)) {
+      progress_bar(prog, total_instances);
+      last_draw = now;
     }
+  };
+
+  if (threads == 1) {
+    for (size_t i = 0; i < total_instances; ++i)
+      generate(i);
+  } else {
+    // A thread principal também trabalha dentro do parallelFor
+    ThreadPool pool(threads - 1);
+    pool.parallelFor(total_instances, generate);
   }
+  fout.flush();
 
-  cout << "\nDone! Total = " << (instance_id - 1) << "\n";
+  cout << "\nDone! Total = " << total_instances << "\n";
   cout << "Output file: " << out_filename << "\n";
   cout << "Strategy: " << strategy << "\n";
+  cout << "Seed: " << seed << "\n";
 
-  return 0;
+  return fout ? 0 : 1;
 }
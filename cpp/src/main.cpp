@@ -1,15 +1,27 @@
 #include "Partition.hpp"
 #include "ReadInstances.hpp"
 #include <algorithm>
-#include <array>
 #include <chrono>
+#include <condition_variable>
 #include <cstdlib>
 #include <fstream>
 #include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <vector>
 
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
 /// @brief Overload the << operator for vectors of integers.
 /// @param os Output stream.
 /// @param v Vector of integers.
@@ -25,146 +37,148 @@ std::ostream &operator<<(std::ostream &os,
 }
 
 /**
- * @brief Writes the partitioned groups and their sums to a CSV file.
+ * @brief Writes the makespan of each algorithm and its time to a CSV file.
  *
  * Now supports a variable number of genetic runs.
- *
- * @tparam K Number of partitions (template)
  */
-template <size_t K>
-void writeInstanceCSV(
-    std::ostream &os, size_t instanceID, int M, int N, int B,
-    partition::ValueType optimalMakespan,
-    const std::array<std::vector<partition::ValueType>, K> &ls,
-    long long lsTime,
-    const std::array<std::vector<partition::ValueType>, K> &lpt,
-    long long lptTime,
-    const std::array<std::vector<partition::ValueType>, K> &multifit,
-    long long multifitTime,
-    const std::array<std::vector<partition::ValueType>, K> &cga,
-    long long cgaTime,
-    const std::array<std::vector<partition::ValueType>, K> &sa, 
-    long long saTime,
-    const std::vector<std::array<std::vector<partition::ValueType>, K>>
-        &geneticRuns,
-    const std::vector<long long> &geneticTimes) {
-
-  auto maxGroupSum =
-      [](const std::array<std::vector<partition::ValueType>, K> &groups) {
-        partition::ValueType maxSum = 0;
-        for (auto &group : groups) {
-          partition::ValueType sum = 0;
-          for (partition::ValueType x : group)
-            sum += x;
-          if (sum > maxSum)
-            maxSum = sum;
-        }
-        return maxSum;
-      };
-
+void writeInstanceCSV(std::ostream &os, size_t instanceID, int M, int N, int B,
+                      partition::ValueType optimalMakespan,
+                      const partition::Assignment &ls, long long lsTime,
+                      const partition::Assignment &lpt, long long lptTime,
+                      const partition::Assignment &multifit,
+                      long long multifitTime, const partition::Assignment &kk,
+                      long long kkTime,
+                      const partition::Assignment &cga, long long cgaTime,
+                      const partition::Assignment &sa, long long saTime,
+                      const std::vector<partition::ValueType> &geneticRuns,
+                      const std::vector<long long> &geneticTimes) {
   os << instanceID << "," << M << "," << N << "," << B << "," << optimalMakespan
-     << "," << maxGroupSum(ls) << "," << lsTime << "," << maxGroupSum(lpt)
-     << "," << lptTime << "," << maxGroupSum(multifit) << "," << multifitTime
-     << "," << maxGroupSum(cga) << "," << cgaTime
-     << "," << maxGroupSum(sa) << "," << saTime;
+     << "," << ls.makespan << "," << lsTime << "," << lpt.makespan << ","
+     << lptTime << "," << multifit.makespan << "," << multifitTime << ","
+     << kk.makespan << "," << kkTime << "," << cga.makespan << "," << cgaTime << "," << sa.makespan << "," << saTime;
 
   // append genetic runs results (count = geneticRuns.size())
   for (size_t i = 0; i < geneticRuns.size(); ++i) {
-    os << "," << maxGroupSum(geneticRuns[i]) << "," << geneticTimes[i];
+    os << "," << geneticRuns[i] << "," << geneticTimes[i];
   }
 
   os << "\n";
 }
 
 /**
- * @brief Macro to generate switch cases for different template instantiations
- * of K.
+ * @brief Writes the search counters of one algorithm run to the stats CSV.
+ */
+void writeStatsCSV(std::ostream &os, size_t instanceID,
+                   const std::string &algorithm,
+                   const partition::SolveStats &stats) {
+  double binsPerProbe =
+      stats.probes ? double(stats.probeBins) / double(stats.probes) : 0.0;
+  os << instanceID << "," << algorithm << "," << stats.nodes << ","
+     << stats.prunedUpper << "," << stats.prunedLower << ","
+     << stats.prunedSymmetry << "," << stats.probes << "," << binsPerProbe
+     << "," << stats.generations << "," << stats.evaluations << ","
+     << stats.cacheHits << "," << stats.proposed << "," << stats.accepted
+     << "," << stats.finalTemperature << ","
+     << std::chrono::duration_cast<std::chrono::microseconds>(stats.timeToBest)
+            .count()
+     << "\n";
+}
+
+/**
+ * @brief Runs an algorithm and measures its wall time.
  *
- * It will execute standard algorithms (LS, LPT, MULTIFIT, CGA, SA) once and the
- * genetic algorithm R times (R = geneticRunsCount local variable).
+ * @param algorithm Callable that solves the instance.
+ * @return The elapsed time in microseconds.
+ */
+template <typename Algorithm> long long timed(Algorithm &&algorithm) {
+  auto start = std::chrono::steady_clock::now();
+  algorithm();
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration_cast<std::chrono::microseconds>(end - start)
+      .count();
+}
+
+/**
+ * @brief Pins the calling thread to one CPU, so that its timings are not
+ * disturbed by migrations. Does nothing outside Linux.
  *
- * The macro assumes it is expanded inside a scope where:
- *  - ARR is the input vector
- *  - INSTANCEID, MVAL, NVAL, BVAL, OPTIMAL, OS are visible
- *  - geneticRunsCount is an `int` with the desired number of genetic runs
+ * @param cpu The CPU index, taken modulo the number of CPUs.
  */
-#define RUN_FOR_K_CSV(KVALUE, ARR, INSTANCEID, MVAL, NVAL, BVAL, OPTIMAL, OS)  \
-  case KVALUE: {                                                               \
-    auto start = std::chrono::steady_clock::now();                             \
-    auto g = partition::LS<KVALUE>(ARR);                                       \
-    auto end = std::chrono::steady_clock::now();                               \
-    auto greedyTime =                                                          \
-        std::chrono::duration_cast<std::chrono::microseconds>(end - start)     \
-            .count();                                                          \
-                                                                               \
-    start = std::chrono::steady_clock::now();                                  \
-    auto l = partition::LPT<KVALUE>(ARR);                                      \
-    end = std::chrono::steady_clock::now();                                    \
-    auto lptTime =                                                             \
-        std::chrono::duration_cast<std::chrono::microseconds>(end - start)     \
-            .count();                                                          \
-                                                                               \
-    start = std::chrono::steady_clock::now();                                  \
-    auto m = partition::MULTIFIT<KVALUE>(ARR);                                 \
-    end = std::chrono::steady_clock::now();                                    \
-    auto multifitTime =                                                        \
-        std::chrono::duration_cast<std::chrono::microseconds>(end - start)     \
-            .count();                                                          \
-                                                                               \
-    start = std::chrono::steady_clock::now();                                  \
-    auto c = partition::CGA<KVALUE>(ARR);                                      \
-    end = std::chrono::steady_clock::now();                                    \
-    auto cgaTime =                                                             \
-        std::chrono::duration_cast<std::chrono::microseconds>(end - start)     \
-            .count();                                                          \
-                                                                               \
-    start = std::chrono::steady_clock::now();                                  \
-    auto sa = partition::SimulatedAnnealing<KVALUE>(ARR);                      \
-    end = std::chrono::steady_clock::now();                                    \
-    auto saTime =                                                              \
-        std::chrono::duration_cast<std::chrono::microseconds>(end - start)     \
-            .count();                                                          \
-                                                                               \
-                                                                               \
-    /* Run genetic algorithm geneticRunsCount times and store results */       \
-    std::vector<std::array<std::vector<partition::ValueType>, KVALUE>>         \
-        geneticRuns;                                                           \
-    std::vector<long long> geneticTimes;                                       \
-    geneticRuns.reserve(geneticRunsCount);                                     \
-    geneticTimes.reserve(geneticRunsCount);                                    \
-    for (int gi = 0; gi < geneticRunsCount; ++gi) {                            \
-      start = std::chrono::steady_clock::now();                                \
-      auto gn = partition::geneticAlgorithm<KVALUE>(ARR);                      \
-      end = std::chrono::steady_clock::now();                                  \
-      auto gTime =                                                             \
-          std::chrono::duration_cast<std::chrono::microseconds>(end - start)   \
-              .count();                                                        \
-      geneticRuns.push_back(std::move(gn));                                    \
-      geneticTimes.push_back(gTime);                                           \
-    }                                                                          \
-                                                                               \
-    writeInstanceCSV<KVALUE>(OS, INSTANCEID, MVAL, NVAL, BVAL, OPTIMAL, g,     \
-                             greedyTime, l, lptTime, m, multifitTime, c,       \
-                             cgaTime, sa, saTime, geneticRuns, geneticTimes);              \
-    break;                                                                     \
+void pinToCpu(std::size_t cpu) {
+#ifdef __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu % std::max(1u, std::thread::hardware_concurrency()), &set);
+  pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+  (void)cpu;
+#endif
+}
+
+/**
+ * @brief Writes CSV rows in instance order while workers finish them in any
+ * order: a row waits until all the rows before it were written.
+ */
+class ReorderBuffer {
+  std::ostream &os_;
+  std::mutex mutex_;
+  std::map<size_t, std::string> pending_; // finished rows, by position
+  size_t next_ = 0;                       // position of the next row to write
+
+public:
+  explicit ReorderBuffer(std::ostream &os) : os_(os) {}
+
+  // Hands in the row at position index and writes every row now in order.
+  void push(size_t index, std::string row) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_.emplace(index, std::move(row));
+    for (auto it = pending_.begin();
+         it != pending_.end() && it->first == next_; it = pending_.erase(it)) {
+      os_ << it->second;
+      next_++;
+    }
+    os_.flush();
   }
+};
 
 /**
  * @brief Class responsible for running partitioning experiments on multiple
  * instances. The number of genetic runs is configurable.
+ *
+ * Instances are spread over a set of worker threads; rows are written in
+ * instance order, and progress is printed periodically. A range of instances
+ * can be run on its own, so that a file is sharded over several runs.
  */
 class ExperimentRunner {
   std::ofstream outFile; // CSV output file stream
+  std::ofstream statsFile; // counters sidecar, with PARTITION_STATS only
   std::string inputFilePath_;
   int geneticRunsCount_; // number of genetic algorithm runs per instance
+  partition::ExactSolver exactSolver_; // solver of the exact (CGA) column
+  size_t threads_;       // worker threads (0 = hardware concurrency)
+  bool pin_;             // pin every worker to its own CPU
+  size_t first_, last_;  // range of instances to run, [first_, last_)
+  bool ownThread_ = false; // keep every solver off the shared pool
+
+  // Result buffers of one worker, reused across its instances
+  struct Buffers {
+    partition::Assignment ls, lpt, multifit, kk, cga, sa, genetic;
+  };
+
+  // Seconds between two progress lines
+  static constexpr int PROGRESS_INTERVAL = 10;
 
 public:
   ExperimentRunner(
       int geneticRunsCount = 5,
       const std::string &inputFilePath = "../instances/instances.txt",
-      const std::string &outputFileName = "../results/balanced-results.csv")
+      const std::string &outputFileName = "../results/balanced-results.csv",
+      partition::ExactSolver exactSolver = partition::ExactSolver::CGA,
+      size_t threads = 1, bool pin = false, size_t first = 0,
+      size_t last = std::numeric_limits<size_t>::max())
       : outFile(outputFileName, std::ios::out), inputFilePath_(inputFilePath),
-        geneticRunsCount_(geneticRunsCount) {
+        geneticRunsCount_(geneticRunsCount), exactSolver_(exactSolver),
+        threads_(threads), pin_(pin), first_(first), last_(last) {
     if (!outFile.is_open()) {
       throw std::runtime_error("Failed to open output file.");
     }
@@ -174,48 +188,252 @@ public:
             << "LS_MaxGroupSum,LS_Time(us),"
                "LPT_MaxGroupSum,LPT_Time(us),"
                "MULTIFIT_MaxGroupSum,MULTIFIT_Time(us),"
-               "CGA_MaxGroupSum,CGA_Time(us),"
-               "SA_MaxGroupSum,SA_Time(us)";
+               "KK_MaxGroupSum,KK_Time(us),"
+            << exactName() << "_MaxGroupSum," << exactName() << "_Time(us),"
+            << "SA_MaxGroupSum,SA_Time(us)";
 
     for (int i = 1; i <= geneticRunsCount_; ++i) {
       outFile << ",Genetic_" << i << "_MaxGroupSum,Genetic_" << i
               << "_Time(us)";
     }
     outFile << "\n";
+
+#if PARTITION_STATS
+    // One row per instance and algorithm, next to the results
+    std::string statsFileName = outputFileName + ".stats.csv";
+    statsFile.open(statsFileName);
+    if (!statsFile.is_open()) {
+      throw std::runtime_error("Failed to open stats file.");
+    }
+    statsFile << "InstanceID,Algorithm,Nodes,PrunedUpper,PrunedLower,"
+                 "PrunedSymmetry,Probes,BinsPerProbe,Generations,"
+                 "Evaluations,CacheHits,MovesProposed,MovesAccepted,"
+                 "FinalTemperature,TimeToBest(us)\n";
+#endif
   }
 
   void run() {
     std::cout << "Reading instances...\n";
-    auto instances = ReadInstances::readInstances(inputFilePath_);
 
-    std::cout << "Running experiments...\n";
-    for (size_t i = 0; i < instances.size(); ++i) {
-      runInstance(instances[i], i + 1);
+    // Binary files are indexed, so workers claim instance numbers and load
+    // only their own instances, concurrently. Text files are parsed lazily
+    // off a shared iterator, and the workers copy each instance out of the
+    // mapping before releasing it
+    std::unique_ptr<ReadInstances::BinaryInstances> binary;
+    std::unique_ptr<ReadInstances::InstanceStream> stream;
+    std::optional<ReadInstances::InstanceStream::iterator> input;
+    size_t first = first_, last = last_, total;
+    if (ReadInstances::isBinaryInstanceFile(inputFilePath_)) {
+      binary = std::make_unique<ReadInstances::BinaryInstances>(inputFilePath_);
+      last = std::min(last, binary->size());
+      first = std::min(first, last);
+      total = last - first;
+    } else {
+      stream = std::make_unique<ReadInstances::InstanceStream>(inputFilePath_);
+      input.emplace(stream->begin());
+      total = stream->size();
+    }
+
+    size_t workers = threads_ > 0
+                         ? threads_
+                         : std::max(1u, std::thread::hardware_concurrency());
+    std::cout << "Running experiments on " << workers << " thread(s)...\n";
+
+    // The shared pool is unpinned and every worker would draw on it, so with
+    // several workers each solver runs on its worker's thread only
+    ownThread_ = workers > 1;
+
+    ReorderBuffer rows(outFile);
+    ReorderBuffer statsRows(statsFile);
+    size_t read = 0;     // instances claimed, guarded by inputMutex
+    size_t consumed = 0; // input handed out, guarded by mutex
+    size_t done = 0;     // guarded by mutex
+    size_t running = workers;
+    std::mutex inputMutex;
+    std::mutex mutex;
+    std::condition_variable finished;
+
+    auto work = [&](size_t worker) {
+      if (pin_) {
+        pinToCpu(worker);
+      }
+      Buffers buffers;
+      ReadInstances::InstanceData instance;
+      std::vector<partition::ValueType> scratch;
+      while (true) {
+        size_t index, offset; // position in the range, input handed out
+        if (binary) {
+          {
+            std::lock_guard<std::mutex> lock(inputMutex);
+            if (first + read == last) {
+              break;
+            }
+            index = read++;
+          }
+          binary->view(first + index, scratch).copyTo(instance);
+          offset = index + 1;
+        } else {
+          std::lock_guard<std::mutex> lock(inputMutex);
+          for (; *input != stream->end() && read < first; ++*input) {
+            read++;
+          }
+          if (*input == stream->end() || read >= last) {
+            break;
+          }
+          (*input)->copyTo(instance);
+          index = read++ - first;
+          ++*input;
+          offset = input->offset();
+        }
+
+        std::ostringstream row, statsRow;
+        runInstance(instance, first + index + 1, buffers, row, statsRow);
+        rows.push(index, row.str());
+        PARTITION_STAT(statsRows.push(index, statsRow.str()));
+
+        std::lock_guard<std::mutex> lock(mutex);
+        done++;
+        consumed = std::max(consumed, offset);
+      }
+
+      std::lock_guard<std::mutex> lock(mutex);
+      if (--running == 0) {
+        finished.notify_all();
+      }
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    for (size_t w = 0; w < workers; w++) {
+      pool.emplace_back(work, w);
     }
+
+    // The main thread only reports progress while the workers run
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      while (!finished.wait_for(lock, std::chrono::seconds(PROGRESS_INTERVAL),
+                                [&] { return running == 0; })) {
+        reportProgress(done, consumed, total, start);
+      }
+    }
+
+    for (auto &thread : pool) {
+      thread.join();
+    }
+    reportProgress(done, total, total, start);
   }
 
+
 private:
-  void runInstance(ReadInstances::InstanceData &instance, size_t id) {
-    std::cout << "Running instance " << id << "\n";
+  const char *exactName() const {
+    switch (exactSolver_) {
+    case partition::ExactSolver::RNP:
+      return "RNP";
+    case partition::ExactSolver::DP:
+      return "DP";
+    case partition::ExactSolver::Auto:
+      return "Exact";
+    default:
+      return "CGA";
+    }
+  }
+
+  // The instance count of a text file is unknown until the input is
+  // exhausted, so its percentage is taken over the bytes parsed so far
+  static void reportProgress(size_t done, size_t consumed, size_t total,
+                             std::chrono::steady_clock::time_point start) {
+    double elapsed = std::chrono::duration<double>(
+                         std::chrono::steady_clock::now() - start)
+                         .count();
+    std::cout << "Progress: " << done << " instances ("
+              << (total ? 100 * consumed / total : 100) << "% of input), "
+              << elapsed << " s" << std::endl;
+  }
+
+  void runInstance(const ReadInstances::InstanceData &instance, size_t id,
+                   Buffers &buffers, std::ostream &os,
+                   std::ostream &statsOs) {
     runAlgorithmsByK(instance.values, id, instance.M, instance.N, instance.B,
-                     instance.optimalSum, outFile);
+                     instance.optimalSum, buffers, os, statsOs);
   }
 
-  void runAlgorithmsByK(std::vector<partition::ValueType> &arr,
+  /**
+   * @brief Executes the standard algorithms (LS, LPT, MULTIFIT, KK, the exact
+   * solver, SA) once and the genetic algorithm geneticRunsCount_ times for any
+   * number of groups Nval. With PARTITION_STATS the counters of every run go
+   * to statsOs.
+   */
+  void runAlgorithmsByK(const std::vector<partition::ValueType> &arr,
                         size_t instanceID, int Mval, int Nval, int Bval,
-                        partition::ValueType optimalSum, std::ostream &os) {
-    // make geneticRunsCount available for the macro
-    int geneticRunsCount = geneticRunsCount_;
-
-    switch (Nval) {
-      RUN_FOR_K_CSV(2, arr, instanceID, Mval, Nval, Bval, optimalSum, os)
-      RUN_FOR_K_CSV(3, arr, instanceID, Mval, Nval, Bval, optimalSum, os)
-      RUN_FOR_K_CSV(4, arr, instanceID, Mval, Nval, Bval, optimalSum, os)
-      RUN_FOR_K_CSV(5, arr, instanceID, Mval, Nval, Bval, optimalSum, os)
-      RUN_FOR_K_CSV(8, arr, instanceID, Mval, Nval, Bval, optimalSum, os)
-    default:
+                        partition::ValueType optimalSum, Buffers &buffers,
+                        std::ostream &os, std::ostream &statsOs) {
+    if (Nval <= 0) {
       os << "[WARN] Unsupported K = " << Nval << "\n";
+      return;
+    }
+    const std::size_t n = static_cast<std::size_t>(Nval);
+
+    // Times one run, collecting its counters when they are compiled in
+    auto run = [&](const std::string &name, auto &&algorithm) {
+#if PARTITION_STATS
+      partition::SolveStats stats;
+      long long time;
+      {
+        partition::StatsScope scope(stats);
+        time = timed(algorithm);
+      }
+      writeStatsCSV(statsOs, instanceID, name, stats);
+      return time;
+#else
+      (void)name;
+      (void)statsOs;
+      return timed(algorithm);
+#endif
+    };
+
+    long long greedyTime =
+        run("LS", [&] { partition::LS(arr, n, buffers.ls); });
+    long long lptTime =
+        run("LPT", [&] { partition::LPT(arr, n, buffers.lpt); });
+    // One FFD probe per round, one chain and a sequential CGA never use the
+    // shared pool; the GA does unless told not to
+    partition::MultifitOptions multifit{7, 1};
+    partition::CgaOptions cga;
+    cga.parallel = false;
+    partition::AnnealingOptions annealing;
+    annealing.chains = 1;
+    partition::GeneticOptions genetic;
+    genetic.parallel = !ownThread_;
+
+    long long multifitTime = run("MULTIFIT", [&] {
+      partition::MULTIFIT(arr, n, buffers.multifit, multifit);
+    });
+    long long kkTime = run("KK", [&] { partition::KK(arr, n, buffers.kk); });
+    long long cgaTime = run(exactName(), [&] {
+      partition::solveExact(arr, n, buffers.cga, exactSolver_, cga);
+    });
+    long long saTime = run("SA", [&] {
+      partition::SimulatedAnnealing(arr, n, buffers.sa, annealing);
+    });
+
+    /* Run genetic algorithm geneticRunsCount_ times and store results */
+    std::vector<partition::ValueType> geneticRuns;
+    std::vector<long long> geneticTimes;
+    geneticRuns.reserve(geneticRunsCount_);
+    geneticTimes.reserve(geneticRunsCount_);
+    for (int gi = 0; gi < geneticRunsCount_; ++gi) {
+      geneticTimes.push_back(
+          run("Genetic_" + std::to_string(gi + 1),
+              [&] {
+                partition::geneticAlgorithm(arr, n, buffers.genetic, genetic);
+              }));
+      geneticRuns.push_back(buffers.genetic.makespan);
     }
+
+    writeInstanceCSV(os, instanceID, Mval, Nval, Bval, optimalSum, buffers.ls,
+                     greedyTime, buffers.lpt, lptTime, buffers.multifit,
+                     multifitTime, buffers.kk, kkTime, buffers.cga, cgaTime,
+                     buffers.sa, saTime, geneticRuns, geneticTimes);
   }
 };
 
@@ -224,6 +442,7 @@ int main(int argc, char **argv) {
     int geneticRuns = 5;
     std::string inPath = ReadInstances::INSTANCE_PATH;
     std::string outPath = "../results/balanced-results.csv";
+    partition::ExactSolver exactSolver = partition::ExactSolver::CGA;
 
     if (argc > 1) {
       int parsed = std::atoi(argv[1]);
@@ -238,11 +457,46 @@ int main(int argc, char **argv) {
     if (argc > 3) {
       outPath = argv[3];
     }
+    if (argc > 4) {
+      std::string name = argv[4];
+      if (name == "rnp") {
+        exactSolver = partition::ExactSolver::RNP;
+      } else if (name == "dp") {
+        exactSolver = partition::ExactSolver::DP;
+      } else if (name == "auto") {
+        exactSolver = partition::ExactSolver::Auto;
+      } else if (name != "cga") {
+        std::cerr << "[WARN] unknown exact solver '" << name
+                  << "', using cga\n";
+      }
+    }
+    size_t threads = 1;
+    if (argc > 5) {
+      threads = static_cast<size_t>(std::atol(argv[5]));
+    }
+    bool pin = argc > 6 && std::string(argv[6]) == "pin";
+
+    // Shard as FIRST:LAST, inclusive instance ids (either side may be empty)
+    size_t first = 0, last = std::numeric_limits<size_t>::max();
+    if (argc > 7) {
+      std::string range = argv[7];
+      size_t colon = range.find(':');
+      std::string from = range.substr(0, colon);
+      std::string to =
+          colon == std::string::npos ? from : range.substr(colon + 1);
+      if (!from.empty()) {
+        first = std::max<size_t>(1, std::stoul(from)) - 1;
+      }
+      if (!to.empty()) {
+        last = std::stoul(to);
+      }
+    }
 
     std::cout << "Using genetic runs = " << geneticRuns << "\n";
     std::cout << "Output CSV = " << outPath << "\n";
 
-    ExperimentRunner runner(geneticRuns, inPath, outPath);
+    ExperimentRunner runner(geneticRuns, inPath, outPath, exactSolver, threads,
+                            pin, first, last);
     runner.run();
     std::cout << "Experiment completed. Results saved to '" << outPath
               << "'.\n";
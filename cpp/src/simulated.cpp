@@ -26,64 +26,52 @@ vector<TaskType> generate_tasks(size_t num_tasks, int min_time = 10,
   return tasks;
 }
 
-// Calcula makespan
-template <size_t n>
-TaskType makespan(const array<vector<TaskType>, n> &allocation) {
-  TaskType max_time = 0;
-  for (const auto &machine_tasks : allocation) {
-    TaskType sum_time = accumulate(machine_tasks.begin(), machine_tasks.end(),
-                                   static_cast<TaskType>(0));
-    if (sum_time > max_time)
-      max_time = sum_time;
-  }
-  return max_time;
-}
-
-// Função template para rodar simulação com número fixo de máquinas
-template <size_t num_machines>
-void run_simulation(ofstream &csv, size_t num_tasks, int winner_makespan[4]) {
-  using array_type = array<vector<TaskType>, num_machines>;
+// Roda a simulação para um número qualquer de máquinas
+void run_simulation(ofstream &csv, size_t num_machines, size_t num_tasks,
+                    int winner_makespan[6]) {
   vector<TaskType> tasks = generate_tasks(num_tasks);
 
   double ideal = std::accumulate(tasks.begin(), tasks.end(), 0.0) / num_machines;
 
-  array<double, 5> makespans{};
-  array<double, 5> distances{};
-  array<double, 5> times_mean{};
-  array<double, 5> times_min{};
-  array<double, 5> times_max{};
+  array<double, 6> makespans{};
+  array<double, 6> distances{};
+  array<double, 6> times_mean{};
+  array<double, 6> times_min{};
+  array<double, 6> times_max{};
 
-  vector<string> algo_names = {"LS", "LPT", "MULTIFIT", "Genetic", "SA"};
+  vector<string> algo_names = {"LS", "LPT", "MULTIFIT", "Genetic", "SA", "KK"};
 
-  for (int algo_idx = 0; algo_idx < 5; ++algo_idx) {
+  for (int algo_idx = 0; algo_idx < 6; ++algo_idx) {
     const int runs = 5;
     vector<double> run_times;
-    array_type allocation;
+    Assignment allocation;
 
     for (int run = 0; run < runs; ++run) {
-      auto tasks_copy = tasks;
       auto start = chrono::steady_clock::now();
 
       switch (algo_idx) {
       case 0:
-        allocation = LS<num_machines>(tasks_copy);
+        LS(tasks, num_machines, allocation);
         break;
       case 1:
-        allocation = LPT<num_machines>(tasks_copy);
+        LPT(tasks, num_machines, allocation);
         break;
       case 2:
-        allocation = MULTIFIT<num_machines>(tasks_copy);
+        MULTIFIT(tasks, num_machines, allocation);
         break;
       case 3:
-        allocation = geneticAlgorithm<num_machines>(tasks_copy);
+        geneticAlgorithm(tasks, num_machines, allocation);
         break;
       case 4:
-        allocation = SimulatedAnnealing<num_machines>(tasks_copy);
+        SimulatedAnnealing(tasks, num_machines, allocation);
+        break;
+      case 5:
+        KK(tasks, num_machines, allocation);
         break;
       }
 
       auto end = chrono::steady_clock::now();
-      makespans[algo_idx] += makespan<num_machines>(allocation);
+      makespans[algo_idx] += allocation.makespan;
       run_times.push_back(chrono::duration<double>(end - start).count());
     }
 
@@ -100,7 +88,7 @@ void run_simulation(ofstream &csv, size_t num_tasks, int winner_makespan[4]) {
       makespans.begin(), min_element(makespans.begin(), makespans.end()));
   winner_makespan[min_makespan_idx]++;
 
-  for (int i = 0; i < 5; ++i) {
+  for (int i = 0; i < 6; ++i) {
     csv << num_machines << "," << num_tasks << "," << algo_names[i] << ","
         << times_mean[i] << "," << times_min[i] << "," << times_max[i] << ","
         << makespans[i] << "," << distances[i] << "\n";
@@ -112,20 +100,20 @@ int main() {
   csv << "NumMachines,NumTasks,Algorithm,TimeMean,TimeMin,TimeMax,Makespan,"
          "MeanDistanceToIdeal\n";
 
-  int winner_makespan[5] = {0, 0, 0, 0, 0};
+  int winner_makespan[6] = {0, 0, 0, 0, 0, 0};
 
   for (size_t num_tasks = 500; num_tasks <= 1000; num_tasks += 100) {
-    run_simulation<30>(csv, num_tasks, winner_makespan);
-    run_simulation<40>(csv, num_tasks, winner_makespan);
-    run_simulation<50>(csv, num_tasks, winner_makespan);
+    run_simulation(csv, 30, num_tasks, winner_makespan);
+    run_simulation(csv, 40, num_tasks, winner_makespan);
+    run_simulation(csv, 50, num_tasks, winner_makespan);
   }
 
   csv.close();
 
   cout << "Simulação concluída. Resultados salvos em results.csv\n";
   cout << "Vitórias por algoritmo (menor makespan):\n";
-  vector<string> algo_names = {"LS", "LPT", "MULTIFIT", "Genetic", "SA"};
-  for (int i = 0; i < 5; ++i)
+  vector<string> algo_names = {"LS", "LPT", "MULTIFIT", "Genetic", "SA", "KK"};
+  for (int i = 0; i < 6; ++i)
     cout << algo_names[i] << ": " << winner_makespan[i] << "\n";
 
   return 0;